@@ -0,0 +1,208 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+
+// NDM includes
+#include <ndm/display/display_rect.hpp>
+
+namespace ndm
+{
+	/**
+	* This class is the set of the rectangles of a display that changed since the last present, so only them are sent to the 
+	* system. The rectangles are coalesced when they are added : two rectangles are merged when their bounding box covers 
+	* less pixels than both of them (overlapping, touching or close rectangles), so the region stays small. When the region is full, the new rectangle is merged with the one that grows the least.
+	* The region has a fixed capacity and never allocates memory.
+	*/
+	class DamageRegion
+	{
+	public:
+
+		// Maximum number of rectangles, a present costs one call to the system per rectangle
+		static constexpr std::size_t capacity = 16;
+
+	private:
+
+		// Attributes
+		std::array<ndm::DisplayRect, capacity> m_rects;
+		std::size_t m_count;
+
+		// Number of pixels covered by a rectangle
+		static inline std::int64_t area(const ndm::DisplayRect & rect) noexcept
+		{
+			return rect.width * rect.height;
+		}
+
+		// Bounding box of two rectangles
+		static inline ndm::DisplayRect unite(const ndm::DisplayRect & a, const ndm::DisplayRect & b) noexcept
+		{
+			const std::int64_t left = std::min(a.x, b.x);
+			const std::int64_t top = std::min(a.y, b.y);
+			const std::int64_t right = std::max(a.x + a.width, b.x + b.width);
+			const std::int64_t bottom = std::max(a.y + a.height, b.y + b.height);
+			return { left, top, right - left, bottom - top };
+		}
+
+		// Remove a rectangle, the order of the rectangles doesn't matter
+		inline void remove(const std::size_t index) noexcept
+		{
+			m_rects[index] = m_rects[m_count - 1];
+			m_count--;
+		}
+
+	public:
+
+		// Constructor
+		inline DamageRegion() noexcept :
+			m_rects(),
+			m_count(0)
+		{
+		}
+
+		/**
+		* This method add a rectangle to the region and coalesce it with the rectangles already in the region.
+		* @param rect The rectangle that changed.
+		*/
+		inline void add(const ndm::DisplayRect & rect) noexcept
+		{
+			if (rect.width <= 0 || rect.height <= 0)
+				return;
+
+			ndm::DisplayRect merged = rect;
+			while (true)
+			{
+				// Merge with the first rectangle that doesn't add pixels to present, the merged rectangle may now reach others
+				bool found = false;
+				for (std::size_t i = 0; i < m_count && found == false; i++)
+				{
+					const ndm::DisplayRect united = unite(m_rects[i], merged);
+					if (area(united) <= area(m_rects[i]) + area(merged))
+					{
+						merged = united;
+						remove(i);
+						found = true;
+					}
+				}
+
+				if (found == true)
+					continue;
+
+				if (m_count < capacity)
+				{
+					m_rects[m_count++] = merged;
+					return;
+				}
+
+				// The region is full, merge with the rectangle whose bounding box adds the least pixels
+				std::size_t best = 0;
+				std::int64_t best_cost = INT64_MAX;
+				for (std::size_t i = 0; i < m_count; i++)
+				{
+					const std::int64_t cost = area(unite(m_rects[i], merged)) - area(m_rects[i]) - area(merged);
+					if (cost < best_cost)
+					{
+						best_cost = cost;
+						best = i;
+					}
+				}
+
+				merged = unite(m_rects[best], merged);
+				remove(best);
+			}
+		}
+
+		/**
+		* This method add a rectangle to the region and coalesce it with the rectangles already in the region.
+		* @param x The x position of the rectangle
+		* @param y The y position of the rectangle
+		* @param width The width of the rectangle
+		* @param height The height of the rectangle
+		*/
+		inline void add(const std::int64_t x, const std::int64_t y, const std::int64_t width, const std::int64_t height) noexcept
+		{
+			add(ndm::DisplayRect { x, y, width, height });
+		}
+
+		/**
+		* This method remove all the rectangles of the region, usually after a present.
+		*/
+		inline void clear() noexcept
+		{
+			m_count = 0;
+		}
+
+		/**
+		* This method clip a rectangle to the size of a surface.
+		* @param rect The rectangle to clip
+		* @param width The width of the surface
+		* @param height The height of the surface
+		* @return DisplayRect The clipped rectangle, it is empty if the rectangle is outside of the surface
+		*/
+		static inline ndm::DisplayRect clip(const ndm::DisplayRect & rect, const std::int64_t width, const std::int64_t height) noexcept
+		{
+			const std::int64_t left = std::clamp<std::int64_t>(rect.x, 0, width);
+			const std::int64_t top = std::clamp<std::int64_t>(rect.y, 0, height);
+			const std::int64_t right = std::clamp<std::int64_t>(rect.x + rect.width, 0, width);
+			const std::int64_t bottom = std::clamp<std::int64_t>(rect.y + rect.height, 0, height);
+			return { left, top, right - left, bottom - top };
+		}
+
+		/**
+		* This method return the number of pixels presented for the region, the pixels shared by two rectangles are counted twice.
+		* @return std::int64_t The area
+		*/
+		inline std::int64_t get_area() const noexcept
+		{
+			std::int64_t total = 0;
+			for (std::size_t i = 0; i < m_count; i++)
+				total += area(m_rects[i]);
+			return total;
+		}
+
+		/**
+		* This method return the bounding box of the region.
+		* @return DisplayRect The bounding box, empty if the region is empty
+		*/
+		inline ndm::DisplayRect get_bounds() const noexcept
+		{
+			if (m_count == 0)
+				return { 0, 0, 0, 0 };
+
+			ndm::DisplayRect bounds = m_rects[0];
+			for (std::size_t i = 1; i < m_count; i++)
+				bounds = unite(bounds, m_rects[i]);
+			return bounds;
+		}
+
+		/**
+		* This method return the number of rectangles in the region.
+		* @return std::size_t The number of rectangles
+		*/
+		inline std::size_t size() const noexcept
+		{
+			return m_count;
+		}
+
+		/**
+		* This method return true if there is no rectangle in the region.
+		* @return bool If the region is empty
+		*/
+		inline bool empty() const noexcept
+		{
+			return m_count == 0;
+		}
+
+		inline const ndm::DisplayRect * begin() const noexcept
+		{
+			return m_rects.data();
+		}
+
+		inline const ndm::DisplayRect * end() const noexcept
+		{
+			return m_rects.data() + m_count;
+		}
+	};
+}
@@ -5,17 +5,32 @@
 #include <string_view>
 #include <vector>
 #include <exception>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <atomic>
 #include <ctype.h>
 
 // NDM includes
 #include <ndm/display/display_events.hpp>
 #include <ndm/display/display_mode.hpp>
+#include <ndm/display/display_geometry.hpp>
+#include <ndm/display/input_state.hpp>
+#include <ndm/trace/trace.hpp>
 #include <ndm/os/win32_functions.hpp>
+#include <ndm/os/x11_functions.hpp>
+#include <ndm/os/egl_functions.hpp>
+#include <ndm/os/vulkan_functions.hpp>
 #include <ndm/monitor/monitor.hpp>
 
 
 namespace ndm
 {
+	class SoftwareFramebuffer;
+	class DisplayManager;
+	class ThreadedDisplay;
+
 	/**
 	* There is no default implementation of this class, some methods need to be defined in an other class for each systems, also, some methods are shared by all the OS 
 	* and are already defined in this header. Each implementation can set attributes or methods in this class but can be only compiled with these, also this library is designed to report 
@@ -27,7 +42,65 @@ namespace ndm
 
 		// Attributes
 		ndm::DisplayEvents m_events;
+		ndm::DisplayGeometry m_geometry;
 		bool m_loaded;
+		bool m_closed;
+		ndm::DisplayMode m_display_mode;
+		ndm::InputState m_input_state;
+
+		// Synchronous resize, the resizes are counted by the thread of the events and the count seen by the last call to 
+		// catch_events() is acknowledged when a frame is presented
+		std::atomic<bool> m_sync_resize;
+		std::atomic<std::uint64_t> m_resize_count;
+		std::uint64_t m_resize_seen;
+		std::atomic<std::uint64_t> m_resize_presented;
+
+		// DPI of the monitor of the display, updated by the events
+		std::uint32_t m_dpi;
+
+		// Client size seen by the thread that reads the events, the renderers follow it instead of the cached geometry that 
+		// the event thread of a ThreadedDisplay updates at the same time
+		std::int64_t m_framebuffer_width;
+		std::int64_t m_framebuffer_height;
+
+		// The wake handle is kept open by unload() when another thread may still wake the display, it is then released by 
+		// release_wake_handle() once that thread can't use it anymore
+		bool m_keep_wake_handle;
+
+		// The events are read by the event thread of a ThreadedDisplay, the renderers must never read them
+		bool m_threaded;
+
+		// The manager reads the events of several displays with a single loop, the threaded display reads them on its own thread
+		friend class ndm::DisplayManager;
+		friend class ndm::ThreadedDisplay;
+
+		/**
+		* This method wait until the display receives an event, the timeout expires or another thread calls wake(), and then 
+		* process the events received by the window. The events are pushed in the ring without consuming the previous ones.
+		* This method need to be implemented for each OS.
+		* @param timeout The maximum time to wait, zero doesn't wait and a negative timeout waits without limit.
+		*/
+		void pump_events(const std::chrono::milliseconds timeout) noexcept;
+
+		/**
+		* This method close the handle used by wake(), wake() does nothing after.
+		* This method need to be implemented for each OS.
+		*/
+		void release_wake_handle() noexcept;
+
+		/**
+		* This method process the events caught by the thread of the display : the resizes are coalesced into the last size,
+		* the resizes are marked as seen, the framebuffer takes the client size and the input state is updated.
+		*/
+		inline void process_caught_events() noexcept
+		{
+			m_events.coalesce(ndm::DisplayEventType::RESIZED);
+			m_resize_seen = m_resize_count.load(std::memory_order_acquire);
+			m_framebuffer_width = m_geometry.client_width;
+			m_framebuffer_height = m_geometry.client_height;
+			for (const ndm::DisplayEvent & event : m_events)
+				m_input_state.apply(event);
+		}
 
 		#if defined(_WIN32) || defined(_WIN64)
 		// Win32 native display attributes
@@ -35,16 +108,149 @@ namespace ndm
 		MSG m_messages;
 		HDC m_device_context;
 		HINSTANCE m_instance;
+		HANDLE m_wake_event;
+
+		// Exclusive fullscreen, the mode is applied again when the application is activated after alt-tab
+		std::string m_win32_fullscreen_device;
+		DEVMODEA m_win32_fullscreen_mode;
+		bool m_win32_mode_changed;
+
+		// Buffer of the raw inputs read in a batch, aligned for the RAWINPUT structures
+		std::vector<std::uint64_t> m_win32_raw_input_buffer;
+
+		// Placement and style of the window before it left the windowed mode
+		WINDOWPLACEMENT m_win32_saved_placement;
+		LONG_PTR m_win32_saved_style;
+
+		// Synchronous resize, the window procedure waits in the resize loop of the system until another thread presents a 
+		// frame with the new size
+		HANDLE m_win32_resize_event;
+		std::atomic<DWORD> m_win32_presenting_thread;
+		bool m_win32_sizing;
+
+		// The focus is tracked to report its changes once, the system sends several messages when the application is deactivated
+		bool m_win32_focused;
+
+		/**
+		* This method change the mode of the monitor to the exclusive fullscreen mode and cover it with the window.
+		* @return bool If the mode has been changed
+		*/
+		bool apply_exclusive_mode() noexcept;
+
+		/**
+		* This method restore the mode of the desktop on the monitor of the exclusive fullscreen mode.
+		*/
+		void restore_exclusive_mode() noexcept;
+
+		// The Win32 events process function updates the native state of the display
+		friend LRESULT CALLBACK ndm::win32_process_events(HWND handle, UINT message, WPARAM wParam, LPARAM lParam);
 		#endif
 
-		#if defined(__linux__)
+		#if defined(__linux__) && !defined(NDM_HEADLESS)
 		// X11 native display attributes
-		Display * m_display;
+		::Display * m_display;
 		Window m_window;
-		XEvent m_events;
+		XEvent m_x11_event;
 		int m_screen;
 		unsigned long m_black_pixel;
 		unsigned long m_white_pixel;
+		Atom m_wm_protocols;
+		Atom m_wm_delete_window;
+		Atom m_net_wm_state;
+		Atom m_net_wm_state_hidden;
+		Atom m_net_wm_state_maximized_vert;
+		Atom m_net_wm_state_maximized_horz;
+		Atom m_net_wm_state_fullscreen;
+		Atom m_net_frame_extents;
+		long m_frame_extents[4];
+
+		// Last geometry confirmed by a configure event (x and y are the origin of the client area on the screen), set_geometry()
+		// updates the cache before the confirmation so the events are compared with this geometry. The window manager 
+		// reparents the window in its frame, the position is then only given by its synthetic configure events
+		ndm::DisplayGeometry m_x11_configured_geometry;
+		bool m_x11_reparented;
+		bool m_minimized;
+		bool m_maximized;
+		bool m_x11_focused;
+		int m_wake_fd;
+
+		// XInput2 sends the raw motion of the mouse, -1 if the extension is missing
+		int m_xi_opcode;
+
+		// MIT-SHM presentation of the software framebuffers, the completions are received with the events of the window. 
+		// They are counted by the thread that reads the events, the event thread of a ThreadedDisplay wakes the renderers 
+		// waiting for a count
+		std::atomic<int> m_shm_completion_type;
+		std::uint64_t m_shm_submissions;
+		std::atomic<std::uint64_t> m_shm_completions;
+
+		// XRandR notifies the changes of the monitors (hotplug, mode or layout change), -1 if the extension is missing
+		int m_randr_event_base;
+
+		// Exclusive fullscreen, the CRTC of the monitor and its mode before the change, the mode is applied again when the 
+		// display receives the focus after alt-tab
+		XID m_x11_fullscreen_crtc;
+		XID m_x11_fullscreen_mode;
+		XID m_x11_saved_mode;
+		unsigned short m_x11_crtc_rotation;
+		int m_x11_crtc_x;
+		int m_x11_crtc_y;
+		std::vector<XID> m_x11_crtc_outputs;
+		bool m_x11_mode_changed;
+
+		// Geometry of the window before it left the windowed mode
+		ndm::DisplayGeometry m_x11_saved_geometry;
+
+		// Synchronous resize with _NET_WM_SYNC_REQUEST, the counter is set to the value of the request when a frame with 
+		// the size of the following configure event is presented
+		Atom m_net_wm_sync_request;
+		Atom m_net_wm_sync_request_counter;
+		XSyncCounter m_x11_sync_counter;
+		bool m_x11_sync_pending;
+		std::atomic<std::int64_t> m_x11_sync_value;
+		std::atomic<std::uint64_t> m_x11_sync_serial;
+		std::uint64_t m_x11_sync_acknowledged;
+
+		// Scale of the content, the Xft.dpi resource of the desktop (0 if it isn't set) is used before the DPI derived from 
+		// the physical size of the monitor under the window
+		Atom m_x11_resource_manager;
+		std::uint32_t m_x11_xft_dpi;
+		std::vector<ndm::X11MonitorDpi> m_x11_monitor_dpis;
+
+		/**
+		* This method update the DPI of the display from the Xft.dpi resource or the monitor under the center of the window.
+		* @param notify If a SCALE_CHANGED event is sent when the DPI changed
+		*/
+		void update_x11_dpi(const bool notify) noexcept;
+
+		/**
+		* This method set the mode of the CRTC of the exclusive fullscreen.
+		* @param mode The mode to set
+		* @return bool If the mode has been set
+		*/
+		bool set_x11_crtc_mode(const XID mode) noexcept;
+
+		/**
+		* This method change the mode of the monitor to the exclusive fullscreen mode.
+		* @return bool If the mode has been changed
+		*/
+		bool apply_exclusive_mode() noexcept;
+
+		/**
+		* This method restore the mode of the desktop on the monitor of the exclusive fullscreen mode.
+		*/
+		void restore_exclusive_mode() noexcept;
+
+		// The X11 events process function updates the native state of the display
+		friend void ndm::x11_process_events(ndm::Display * display, const XEvent & event);
+		friend class ndm::SoftwareFramebuffer;
+		#endif
+
+		#if defined(__linux__) && defined(NDM_HEADLESS)
+		// EGL headless display attributes, the display is an offscreen surface without window
+		EGLDisplay m_egl_display;
+		ndm::DisplayGeometry m_egl_reported_geometry;
+		int m_wake_fd;
 		#endif
 
 	public:
@@ -54,9 +260,63 @@ namespace ndm
 		* This class is a singleton so if a display already exist, an exception is thrown. If not, the global instance is set.
 		*/
 		inline Display() : 
-			m_loaded(false) 
+			m_geometry(),
+			m_loaded(false),
+			m_closed(false),
+			m_display_mode(ndm::DisplayMode::WINDOWED),
+			m_input_state(),
+			m_sync_resize(false),
+			m_resize_count(0),
+			m_resize_seen(0),
+			m_resize_presented(0),
+			m_dpi(ndm::DEFAULT_DPI),
+			m_framebuffer_width(0),
+			m_framebuffer_height(0),
+			m_keep_wake_handle(false),
+			m_threaded(false)
 		{
-			std::memset(&m_events, 0, sizeof(ndm::DisplayEvents));
+			#if defined(_WIN32) || defined(_WIN64)
+			m_wake_event = nullptr;
+			std::memset(&m_win32_fullscreen_mode, 0, sizeof(DEVMODEA));
+			m_win32_mode_changed = false;
+			std::memset(&m_win32_saved_placement, 0, sizeof(WINDOWPLACEMENT));
+			m_win32_saved_style = 0;
+			m_win32_resize_event = nullptr;
+			m_win32_presenting_thread = 0;
+			m_win32_sizing = false;
+			m_win32_focused = false;
+			#endif
+
+			#if defined(__linux__) && !defined(NDM_HEADLESS)
+			m_wake_fd = -1;
+			m_shm_completion_type = -1;
+			m_shm_submissions = 0;
+			m_shm_completions = 0;
+			m_randr_event_base = -1;
+			m_x11_focused = false;
+			m_x11_configured_geometry = {};
+			m_x11_reparented = false;
+			m_xi_opcode = -1;
+			m_x11_fullscreen_crtc = 0;
+			m_x11_fullscreen_mode = 0;
+			m_x11_saved_mode = 0;
+			m_x11_crtc_rotation = 0;
+			m_x11_crtc_x = 0;
+			m_x11_crtc_y = 0;
+			m_x11_mode_changed = false;
+			m_x11_sync_counter = None;
+			m_x11_sync_pending = false;
+			m_x11_sync_value = 0;
+			m_x11_sync_serial = 0;
+			m_x11_sync_acknowledged = 0;
+			m_x11_resource_manager = None;
+			m_x11_xft_dpi = 0;
+			#endif
+
+			#if defined(__linux__) && defined(NDM_HEADLESS)
+			m_egl_display = EGL_NO_DISPLAY;
+			m_wake_fd = -1;
+			#endif
 		}
 
 		/**
@@ -76,11 +336,51 @@ namespace ndm
 		}
 
 		/**
-		* This method must return all the events catched by the window.
+		* This method must return all the events catched by the window since the last call, the events of the previous call are consumed.
+		* The resizes are coalesced, only the last RESIZED event is kept with the last size of the client area.
+		* The displays added to a DisplayManager are read by the manager instead.
+		* @return DisplayEvents& The events ring, iterable with a range-for
+		*/
+		inline ndm::DisplayEvents & catch_events() noexcept
+		{
+			NDM_TRACE_SCOPE("Display::catch_events");
+			m_events.clear();
+			m_input_state.begin_frame();
+			pump_events(std::chrono::milliseconds(0));
+			process_caught_events();
+			return m_events;
+		}
+
+		/**
+		* This method wait until the display receives an event, the timeout expires or another thread calls wake(), and then 
+		* return all the events catched by the window like catch_events(). The thread doesn't use the CPU while waiting.
+		* @param timeout The maximum time to wait, a negative timeout waits without limit.
+		* @return DisplayEvents& The events ring, iterable with a range-for
+		*/
+		inline ndm::DisplayEvents & wait_events(const std::chrono::milliseconds timeout) noexcept
+		{
+			NDM_TRACE_SCOPE("Display::wait_events");
+			m_events.clear();
+			m_input_state.begin_frame();
+			pump_events(timeout);
+			process_caught_events();
+			return m_events;
+		}
+
+		/**
+		* This method wait without limit until the display receives an event or another thread calls wake().
+		* @return DisplayEvents& The events ring, iterable with a range-for
+		*/
+		inline ndm::DisplayEvents & wait_events() noexcept
+		{
+			return wait_events(std::chrono::milliseconds(-1));
+		}
+
+		/**
+		* This method wake up the thread waiting in wait_events(), it can be called from any thread.
 		* This method need to be implemented for each OS.
-		* @return DisplayEvents& The events structure
 		*/
-		ndm::DisplayEvents catch_events() noexcept;
+		void wake() noexcept;
 
 		/**
 		* This method load the display.
@@ -98,11 +398,34 @@ namespace ndm
 		void unload();
 
 		/**
-		* This method set the display on full screen mode or not.
+		* This method set the display on full screen mode or not. The placement of the window is saved when it leaves the 
+		* windowed mode and restored when it comes back.
 		* This method need to be implemented for each OS.
-		* @param fullscreen If the full screen mode is activated or not.
+		* @param mode The fullscreen or windowed mode.
+		* @param monitor The monitor to cover in fullscreen.
+		* @param capabilities The mode of the monitor in exclusive fullscreen, ignored by the other modes.
+		*/
+		void set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor, const ndm::MonitorCapabilities & capabilities);
+
+		/**
+		* This method set the display on full screen mode or not, the exclusive fullscreen uses the largest mode of the monitor.
+		* @param mode The fullscreen or windowed mode.
+		* @param monitor The monitor to cover in fullscreen.
+		*/
+		inline void set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor)
+		{
+			const auto [width, height] = monitor.get_max_size();
+			set_display_mode(mode, monitor, monitor.get_closest_capabilities(width, height, monitor.get_max_refresh_rate()));
+		}
+
+		/**
+		* This method return the current mode of the display.
+		* @return DisplayMode The mode
 		*/
-		void set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor);
+		inline ndm::DisplayMode get_display_mode() const noexcept
+		{
+			return m_display_mode;
+		}
 
 		/**
 		* This method set the display resizable by the user (minimize, maximize...).
@@ -111,6 +434,34 @@ namespace ndm
 		*/
 		void set_resizable_by_user(const bool resizable);
 
+		/**
+		* This method enable the synchronous resize : the window manager waits until a frame with the new size is presented
+		* before it shows the resized window, instead of a stretched or an empty frame. The frames are acknowledged by the
+		* presentation of the GLContext and of the SoftwareFramebuffer, a renderer that presents its frames itself calls
+		* acknowledge_resize(). X11 uses the _NET_WM_SYNC_REQUEST protocol. On Win32, the window procedure waits in the
+		* resize loop of the system until another thread presents the frame (ThreadedDisplay), it doesn't wait when the
+		* frames are presented by the thread of the events.
+		* This method need to be implemented for each OS.
+		* @param enabled If the resize is synchronous.
+		*/
+		void set_sync_resize(const bool enabled);
+
+		/**
+		* This method return true if the resize is synchronous.
+		* @return bool If the resize is synchronous
+		*/
+		inline bool is_sync_resize() const noexcept
+		{
+			return m_sync_resize.load(std::memory_order_relaxed);
+		}
+
+		/**
+		* This method tell the window manager that a frame with the sizes caught by the last call to catch_events() has
+		* been presented, it must be called by the thread that presents the frames.
+		* This method need to be implemented for each OS.
+		*/
+		void acknowledge_resize() noexcept;
+
 		/**
 		* This method set the title of the display.
 		* This method need to be implemented for each OS.
@@ -161,32 +512,127 @@ namespace ndm
 		bool has_focus() const;
 
 		/**
-		* This method get the x position of the display on the screen.
+		* This method set the position and the outer size of the display with a single call to the OS.
 		* This method need to be implemented for each OS.
+		* @param x The x position
+		* @param y The y position
+		* @param width The width of the display
+		* @param height The height of the display
+		*/
+		void set_geometry(const std::int64_t x, const std::int64_t y, const std::uint64_t width, const std::uint64_t height);
+
+		/**
+		* This method get the x position of the display on the screen from the cached geometry.
 		* @return The x position of the display on the screen.
 		*/
-		std::int64_t get_x() const;
+		inline std::int64_t get_x() const noexcept
+		{
+			return m_loaded == true ? m_geometry.x : -1;
+		}
 
 		/**
-		* This method get the y position of the display on the screen.
-		* This method need to be implemented for each OS.
+		* This method get the y position of the display on the screen from the cached geometry.
 		* @return The y position of the display on the screen.
 		*/
-		std::int64_t get_y() const;
+		inline std::int64_t get_y() const noexcept
+		{
+			return m_loaded == true ? m_geometry.y : -1;
+		}
 
 		/**
-		* This method get the width of the display.
-		* This method need to be implemented for each OS.
-		* @return The width position of the display.
+		* This method get the outer width of the display from the cached geometry.
+		* @return The width of the display.
 		*/
-		std::int64_t get_width() const;
+		inline std::int64_t get_width() const noexcept
+		{
+			return m_loaded == true ? m_geometry.width : -1;
+		}
 
 		/**
-		* This method get the height of the display.
-		* This method need to be implemented for each OS.
-		* @return The height position of the display.
+		* This method get the outer height of the display from the cached geometry.
+		* @return The height of the display.
+		*/
+		inline std::int64_t get_height() const noexcept
+		{
+			return m_loaded == true ? m_geometry.height : -1;
+		}
+
+		/**
+		* This method get the width of the drawable area of the display from the cached geometry.
+		* @return The client width of the display.
+		*/
+		inline std::int64_t get_client_width() const noexcept
+		{
+			return m_loaded == true ? m_geometry.client_width : -1;
+		}
+
+		/**
+		* This method get the height of the drawable area of the display from the cached geometry.
+		* @return The client height of the display.
+		*/
+		inline std::int64_t get_client_height() const noexcept
+		{
+			return m_loaded == true ? m_geometry.client_height : -1;
+		}
+
+		/**
+		* This method get the width of the framebuffer of the display in pixels, the size of the viewport of the renderer.
+		* The client area is measured in physical pixels on every system (the process is per-monitor DPI aware on Win32),
+		* so the framebuffer has the client size seen by the last call to catch_events(). The renderers use it, so they 
+		* never read the geometry while the event thread of a ThreadedDisplay writes it.
+		* @return The framebuffer width of the display.
+		*/
+		inline std::int64_t get_framebuffer_width() const noexcept
+		{
+			return m_loaded == true ? m_framebuffer_width : -1;
+		}
+
+		/**
+		* This method get the height of the framebuffer of the display in pixels, the size of the viewport of the renderer.
+		* @return The framebuffer height of the display.
+		*/
+		inline std::int64_t get_framebuffer_height() const noexcept
+		{
+			return m_loaded == true ? m_framebuffer_height : -1;
+		}
+
+		/**
+		* This method get the DPI of the monitor of the display, a SCALE_CHANGED event is sent when it changes.
+		* @return The DPI of the display, DEFAULT_DPI for a scale of 1.
 		*/
-		std::int64_t get_height() const;
+		inline std::uint32_t get_dpi() const noexcept
+		{
+			return m_dpi;
+		}
+
+		/**
+		* This method get the scale of the content of the display, the size of the user interface is multiplied by this scale
+		* so it keeps the same physical size on every monitor.
+		* @return The content scale, 1 for DEFAULT_DPI.
+		*/
+		inline float get_content_scale() const noexcept
+		{
+			return static_cast<float>(m_dpi) / static_cast<float>(ndm::DEFAULT_DPI);
+		}
+
+		/**
+		* This method return the cached geometry of the display.
+		* @return DisplayGeometry & The geometry structure
+		*/
+		inline const ndm::DisplayGeometry & get_geometry() const noexcept
+		{
+			return m_geometry;
+		}
+
+		/**
+		* This method return the state of the keyboard and the mouse, updated by the last call to catch_events() or wait_events().
+		* The state can be copied with memcpy, a copy can be handed to another thread without lock.
+		* @return InputState & The input state
+		*/
+		inline const ndm::InputState & get_input_state() const noexcept
+		{
+			return m_input_state;
+		}
 
 		/**
 		* This method return the internal events struct.
@@ -215,5 +661,42 @@ namespace ndm
 		HINSTANCE & get_win32_instance();
 
 		#endif
+
+		#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+		::Display * get_x11_display() const;
+
+		Window get_x11_window() const;
+
+		int get_x11_screen() const;
+
+		#endif
+
+		#if defined(__linux__) && defined(NDM_HEADLESS)
+
+		EGLDisplay get_egl_display() const;
+
+		#endif
+
+		#if defined(NDM_ENABLE_VULKAN)
+
+		/**
+		* This method return the instance extensions needed to create a surface with create_vulkan_surface(), they must be 
+		* enabled when the instance is created.
+		* This method need to be implemented for each OS.
+		* @return std::vector<const char *> The names of the extensions
+		*/
+		static std::vector<const char *> get_vulkan_instance_extensions();
+
+		/**
+		* This method create a Vulkan surface for the window of the display, the surface must be destroyed with 
+		* vkDestroySurfaceKHR() before the display is unloaded. If the surface cannot be created, an exception is thrown.
+		* This method need to be implemented for each OS.
+		* @param instance The instance created with the extensions of get_vulkan_instance_extensions()
+		* @return VkSurfaceKHR The surface
+		*/
+		VkSurfaceKHR create_vulkan_surface(VkInstance instance) const;
+
+		#endif
 	};
 }
@@ -0,0 +1,29 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <array>
+
+// NDM includes
+#include <ndm/display/display_command_type.hpp>
+
+namespace ndm
+{
+	/**
+	* This structure represent one command sent by the render thread to the event thread of a threaded display.
+	* The payload depends on the type of the command :
+	* - SET_GEOMETRY : x, y, width and height are the new geometry of the display
+	* - SET_TITLE : title is the new title, truncated and null terminated
+	* - SET_VISIBLE, SET_RESIZABLE, SET_SYNC_RESIZE : enabled is the new state
+	*/
+	struct DisplayCommand
+	{
+		ndm::DisplayCommandType type;
+		std::int64_t x;
+		std::int64_t y;
+		std::uint64_t width;
+		std::uint64_t height;
+		bool enabled;
+		std::array<char, 256> title;
+	};
+}
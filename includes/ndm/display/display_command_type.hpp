@@ -0,0 +1,19 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/*
+	* Enumeration that represent the type of a command sent to a threaded display.
+	*/
+	enum class DisplayCommandType : std::uint8_t
+	{
+		SET_GEOMETRY,
+		SET_TITLE,
+		SET_VISIBLE,
+		SET_RESIZABLE,
+		SET_SYNC_RESIZE
+	};
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// STD includes
+#include <cstddef>
+#include <atomic>
+#include <array>
+
+// NDM includes
+#include <ndm/display/display_command.hpp>
+
+namespace ndm
+{
+	/**
+	* This class is a fixed-capacity ring buffer of the commands sent to a threaded display. Like DisplayEvents, it is a 
+	* lock-free single producer / single consumer queue : the render thread pushes the commands and the event thread 
+	* pops them, no memory is allocated after the construction.
+	*/
+	class DisplayCommands
+	{
+	public:
+
+		// The capacity must be a power of two
+		static constexpr std::size_t capacity = 64;
+
+	private:
+
+		static_assert((capacity & (capacity - 1)) == 0, "The capacity of the commands ring must be a power of two !");
+
+		// Attributes
+		std::array<ndm::DisplayCommand, capacity> m_records;
+		alignas(64) std::atomic<std::size_t> m_head;
+		alignas(64) std::atomic<std::size_t> m_tail;
+
+	public:
+
+		/**
+		* Constructor of this class.
+		*/
+		inline DisplayCommands() noexcept : 
+			m_records(), 
+			m_head(0), 
+			m_tail(0)
+		{
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline DisplayCommands(DisplayCommands &) = delete;
+		inline DisplayCommands(const DisplayCommands &) = delete;
+
+		/**
+		* This method push a command at the end of the ring, it must only be called by the producer.
+		* @param command The command to push.
+		* @return bool False if the ring is full and the command was not pushed.
+		*/
+		inline bool push(const ndm::DisplayCommand & command) noexcept
+		{
+			const std::size_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) >= capacity)
+				return false;
+
+			m_records[head & (capacity - 1)] = command;
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		* This method remove the oldest command of the ring, it must only be called by the consumer.
+		* @param command The structure that receive the removed command.
+		* @return bool False if the ring is empty.
+		*/
+		inline bool pop(ndm::DisplayCommand & command) noexcept
+		{
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail == m_head.load(std::memory_order_acquire))
+				return false;
+
+			command = m_records[tail & (capacity - 1)];
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+	};
+}
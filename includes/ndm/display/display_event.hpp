@@ -0,0 +1,46 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <chrono>
+
+// NDM includes
+#include <ndm/display/display_event_type.hpp>
+
+namespace ndm
+{
+	// Wheel delta of one notch, like WHEEL_DELTA on Win32
+	constexpr std::int64_t MOUSE_WHEEL_STEP = 120;
+
+	// DPI of a content scale of 1, like USER_DEFAULT_SCREEN_DPI on Win32
+	constexpr std::uint32_t DEFAULT_DPI = 96;
+
+	/**
+	* This structure represent one event reported by a display, with the time at which it was received and its payload.
+	* The payload depends on the type of the event :
+	* - RESIZED, MINIMIZED, MAXIMIZED : width and height are the new size of the display
+	* - MOVED : x and y are the new position of the top-left corner of the display, decorations included (like DisplayGeometry)
+	* - CLOSED, MONITORS_CHANGED : no payload
+	* - KEY_PRESSED, KEY_RELEASED : scan_code is the hardware code of the key, key is the symbol of the key without modifier
+	*   (virtual key code on Win32, KeySym on X11)
+	* - MOUSE_BUTTON_PRESSED, MOUSE_BUTTON_RELEASED : key is the button (1 left, 2 middle, 3 right, 4 and 5 the extra
+	*   buttons), x and y are the position of the cursor in the client area
+	* - MOUSE_WHEEL : x and y are the horizontal and vertical deltas, in MOUSE_WHEEL_STEP for one notch
+	* - MOUSE_MOVED : x and y are the position of the cursor in the client area
+	* - MOUSE_RAW_MOTION : x and y are the relative motion of the mouse in device units, without acceleration
+	* - SCALE_CHANGED : x is the new DPI of the display (DEFAULT_DPI for a scale of 1), width and height are the size of the
+	*   framebuffer in pixels
+	* - FOCUS_GAINED, FOCUS_LOST : no payload, the keys and the buttons held when the focus is lost are released
+	*/
+	struct DisplayEvent
+	{
+		ndm::DisplayEventType type;
+		std::chrono::steady_clock::time_point timestamp;
+		std::int64_t x;
+		std::int64_t y;
+		std::int64_t width;
+		std::int64_t height;
+		std::uint32_t scan_code;
+		std::uint32_t key;
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/*
+	* Enumeration that represent the type of an event reported by a display.
+	*/
+	enum class DisplayEventType : std::uint8_t
+	{
+		RESIZED,
+		CLOSED,
+		MINIMIZED,
+		MAXIMIZED,
+		MOVED,
+		MONITORS_CHANGED,
+		KEY_PRESSED,
+		KEY_RELEASED,
+		MOUSE_BUTTON_PRESSED,
+		MOUSE_BUTTON_RELEASED,
+		MOUSE_WHEEL,
+		MOUSE_MOVED,
+		MOUSE_RAW_MOTION,
+		SCALE_CHANGED,
+		FOCUS_GAINED,
+		FOCUS_LOST
+	};
+}
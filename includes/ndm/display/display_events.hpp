@@ -1,19 +1,249 @@
 #pragma once
 
+// STD includes
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <array>
+#include <chrono>
+
+// NDM includes
+#include <ndm/display/display_event.hpp>
+
 namespace ndm
 {
 	/**
-	* This structure represent all the events happening during the execution by a display, getters for all 
-	* of them are defined in the display class directly, all implementations must use this structure to report 
-	* all the following events :
-	* - display resized, minimized, maximized, moved, closed, language changed
+	* This class is a fixed-capacity ring buffer of all the events happening during the execution by a display.
+	* It is a lock-free single producer / single consumer queue : the OS events process function pushes the events
+	* and the application iterates them with a range-for, no memory is allocated after the construction.
+	* When the ring is full, new events are dropped and counted.
 	*/
-	struct DisplayEvents
+	class DisplayEvents
 	{
-		bool resized;
-		bool closed;
-		bool minimized;
-		bool maximized;
-		bool moved;
+	public:
+
+		// The capacity must be a power of two
+		static constexpr std::size_t capacity = 1024;
+
+		/**
+		* Forward iterator over the events that are not consumed yet.
+		*/
+		class Iterator
+		{
+		private:
+
+			const ndm::DisplayEvent * m_records;
+			std::size_t m_index;
+
+		public:
+
+			inline Iterator(const ndm::DisplayEvent * records, const std::size_t index) noexcept : 
+				m_records(records), 
+				m_index(index) 
+			{
+			}
+
+			inline const ndm::DisplayEvent & operator*() const noexcept
+			{
+				return m_records[m_index & (capacity - 1)];
+			}
+
+			inline const ndm::DisplayEvent * operator->() const noexcept
+			{
+				return &m_records[m_index & (capacity - 1)];
+			}
+
+			inline Iterator & operator++() noexcept
+			{
+				m_index++;
+				return *this;
+			}
+
+			inline bool operator!=(const Iterator & other) const noexcept
+			{
+				return m_index != other.m_index;
+			}
+
+			inline bool operator==(const Iterator & other) const noexcept
+			{
+				return m_index == other.m_index;
+			}
+		};
+
+	private:
+
+		static_assert((capacity & (capacity - 1)) == 0, "The capacity of the events ring must be a power of two !");
+
+		// Attributes
+		std::array<ndm::DisplayEvent, capacity> m_records;
+		alignas(64) std::atomic<std::size_t> m_head;
+		alignas(64) std::atomic<std::size_t> m_tail;
+		alignas(64) std::atomic<std::size_t> m_dropped;
+
+	public:
+
+		/**
+		* Constructor of this class.
+		*/
+		inline DisplayEvents() noexcept : 
+			m_records(), 
+			m_head(0), 
+			m_tail(0), 
+			m_dropped(0) 
+		{
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline DisplayEvents(DisplayEvents &) = delete;
+		inline DisplayEvents(const DisplayEvents &) = delete;
+
+		/**
+		* This method push an event at the end of the ring, it must only be called by the producer.
+		* @param event The event to push.
+		* @return bool False if the ring is full and the event was dropped.
+		*/
+		inline bool push(const ndm::DisplayEvent & event) noexcept
+		{
+			const std::size_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) >= capacity)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			m_records[head & (capacity - 1)] = event;
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		* This method push an event timestamped now at the end of the ring, it must only be called by the producer.
+		* @param type The type of the event.
+		* @param x The x payload of the event.
+		* @param y The y payload of the event.
+		* @param width The width payload of the event.
+		* @param height The height payload of the event.
+		* @param scan_code The scan code payload of the event.
+		* @param key The key payload of the event.
+		* @return bool False if the ring is full and the event was dropped.
+		*/
+		inline bool push(const ndm::DisplayEventType type, const std::int64_t x = 0, const std::int64_t y = 0, 
+						 const std::int64_t width = 0, const std::int64_t height = 0, 
+						 const std::uint32_t scan_code = 0, const std::uint32_t key = 0) noexcept
+		{
+			return push(ndm::DisplayEvent { type, std::chrono::steady_clock::now(), x, y, width, height, scan_code, key });
+		}
+
+		/**
+		* This method remove the oldest event of the ring, it must only be called by the consumer.
+		* @param event The structure that receive the removed event.
+		* @return bool False if the ring is empty.
+		*/
+		inline bool pop(ndm::DisplayEvent & event) noexcept
+		{
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail == m_head.load(std::memory_order_acquire))
+				return false;
+
+			event = m_records[tail & (capacity - 1)];
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		* This method consume all the events of the ring, it must only be called by the consumer.
+		*/
+		inline void clear() noexcept
+		{
+			m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+		}
+
+		/**
+		* This method return true if an event of the given type is in the ring.
+		* @param type The type of event to look for.
+		* @return bool If an event of this type is in the ring.
+		*/
+		inline bool contains(const ndm::DisplayEventType type) const noexcept
+		{
+			for (const ndm::DisplayEvent & event : *this)
+				if (event.type == type)
+					return true;
+
+			return false;
+		}
+
+		/**
+		* This method keep only the last event of the given type, the other events keep their order. A storm of resizes is
+		* reported with the last size only. It must only be called by a consumer that is also the producer, or when the
+		* producer doesn't push at the same time.
+		* @param type The type of event to coalesce.
+		*/
+		inline void coalesce(const ndm::DisplayEventType type) noexcept
+		{
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			const std::size_t head = m_head.load(std::memory_order_acquire);
+
+			std::size_t last = head;
+			for (std::size_t i = head; i-- > tail;)
+			{
+				if (m_records[i & (capacity - 1)].type == type)
+				{
+					last = i;
+					break;
+				}
+			}
+			if (last == head)
+				return;
+
+			// The events kept before the last one are moved towards it, the tail then skips the removed events
+			std::size_t write = last;
+			for (std::size_t i = last; i-- > tail;)
+			{
+				if (m_records[i & (capacity - 1)].type == type)
+					continue;
+				write--;
+				m_records[write & (capacity - 1)] = m_records[i & (capacity - 1)];
+			}
+			m_tail.store(write, std::memory_order_release);
+		}
+
+		/**
+		* This method return the number of events in the ring.
+		* @return std::size_t The number of events.
+		*/
+		inline std::size_t size() const noexcept
+		{
+			return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+		}
+
+		/**
+		* This method return true if there is no event in the ring.
+		* @return bool If the ring is empty.
+		*/
+		inline bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		/**
+		* This method return the number of events dropped because the ring was full.
+		* @return std::size_t The number of dropped events.
+		*/
+		inline std::size_t get_dropped_count() const noexcept
+		{
+			return m_dropped.load(std::memory_order_relaxed);
+		}
+
+		inline Iterator begin() const noexcept
+		{
+			return Iterator(m_records.data(), m_tail.load(std::memory_order_acquire));
+		}
+
+		inline Iterator end() const noexcept
+		{
+			return Iterator(m_records.data(), m_head.load(std::memory_order_acquire));
+		}
 	};
-}
\ No newline at end of file
+}
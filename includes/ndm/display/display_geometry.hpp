@@ -0,0 +1,24 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/**
+	* This structure represent the geometry of a display on the screen. It is cached by the display and updated 
+	* from the move and resize events of the OS, so reading it never calls the OS.
+	* - x, y : the position of the top-left corner of the window, decorations included
+	* - width, height : the outer size of the window, decorations included
+	* - client_width, client_height : the size of the drawable area of the window
+	*/
+	struct DisplayGeometry
+	{
+		std::int64_t x;
+		std::int64_t y;
+		std::int64_t width;
+		std::int64_t height;
+		std::int64_t client_width;
+		std::int64_t client_height;
+	};
+}
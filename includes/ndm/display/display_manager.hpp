@@ -0,0 +1,190 @@
+#pragma once
+
+// STD includes
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/display/display_manager_event.hpp>
+
+#if defined(__linux__)
+#include <poll.h>
+#endif
+
+namespace ndm
+{
+	/**
+	* This class owns the event loop of several displays of the same thread (a main view and its tool windows). Each call
+	* drains the events of the system once for all the displays and reports them tagged with their display, instead of
+	* calling catch_events() on each display. The events of a display are also available in its own events ring until 
+	* the next call.
+	* The displays are not owned by the manager, they must be removed before being destroyed.
+	*/
+	class DisplayManager
+	{
+	private:
+
+		// Attributes
+		std::vector<ndm::Display *> m_displays;
+		std::vector<ndm::DisplayManagerEvent> m_events;
+		bool m_loaded;
+
+		#if defined(_WIN32) || defined(_WIN64)
+		// Win32 native manager attributes, the messages of every window of the thread are read by the same loop
+		MSG m_messages;
+		HANDLE m_wake_event;
+		std::vector<HANDLE> m_wait_handles;
+		#endif
+
+		#if defined(__linux__)
+		// Linux native manager attributes, the file descriptors of every display are polled together
+		int m_wake_fd;
+		std::vector<pollfd> m_poll_fds;
+		#endif
+
+		/**
+		* This method consume the events of the previous call in every display.
+		*/
+		inline void clear_events() noexcept
+		{
+			m_events.clear();
+			for (ndm::Display * display : m_displays)
+			{
+				display->get_events().clear();
+				display->m_input_state.begin_frame();
+			}
+		}
+
+		/**
+		* This method copy the events received by the displays, tagged with their display.
+		*/
+		inline void collect_events()
+		{
+			for (ndm::Display * display : m_displays)
+			{
+				display->process_caught_events();
+				for (const ndm::DisplayEvent & event : display->get_events())
+					m_events.push_back(ndm::DisplayManagerEvent { display, event });
+			}
+		}
+
+	public:
+
+		// Constructor
+		inline DisplayManager() :
+			m_loaded(false)
+		{
+			#if defined(_WIN32) || defined(_WIN64)
+			std::memset(&m_messages, 0, sizeof(MSG));
+			m_wake_event = nullptr;
+			#endif
+
+			#if defined(__linux__)
+			m_wake_fd = -1;
+			#endif
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline DisplayManager(DisplayManager &) = delete;
+		inline DisplayManager(const DisplayManager &) = delete;
+
+		// Destructor
+		inline virtual ~DisplayManager()
+		{
+			if (m_loaded == true)
+				unload();
+		}
+
+		/**
+		* This method load the manager.
+		* This method need to be implemented for each OS.
+		*/
+		void load();
+
+		/**
+		* This method unload the manager, the displays stay loaded.
+		* This method need to be implemented for each OS.
+		*/
+		void unload();
+
+		/**
+		* This method add a loaded display to the manager, the display must be created by the thread of the manager.
+		* @param display_ptr The display to add
+		*/
+		inline void add(ndm::Display * display_ptr)
+		{
+			if (display_ptr == nullptr || display_ptr->is_loaded() == false)
+				throw std::runtime_error("Can't add a display that is not loaded !");
+
+			if (std::find(m_displays.begin(), m_displays.end(), display_ptr) == m_displays.end())
+				m_displays.push_back(display_ptr);
+
+			// The events of all the displays fit in the list without allocation during the event loop
+			m_events.reserve(m_displays.size() * ndm::DisplayEvents::capacity);
+		}
+
+		/**
+		* This method remove a display from the manager.
+		* @param display_ptr The display to remove
+		*/
+		inline void remove(ndm::Display * display_ptr) noexcept
+		{
+			m_displays.erase(std::remove(m_displays.begin(), m_displays.end(), display_ptr), m_displays.end());
+		}
+
+		/**
+		* This method return all the events catched by the displays since the last call, the events of the previous call 
+		* are consumed. The messages of the system are read once for all the displays.
+		* This method need to be implemented for each OS.
+		* @return std::vector<DisplayManagerEvent> & The events of all the displays, in the order of the displays
+		*/
+		const std::vector<ndm::DisplayManagerEvent> & catch_events() noexcept;
+
+		/**
+		* This method wait until a display receives an event, the timeout expires or another thread calls wake() on the
+		* manager or on a display, and then return all the events like catch_events().
+		* This method need to be implemented for each OS.
+		* @param timeout The maximum time to wait, a negative timeout waits without limit.
+		* @return std::vector<DisplayManagerEvent> & The events of all the displays
+		*/
+		const std::vector<ndm::DisplayManagerEvent> & wait_events(const std::chrono::milliseconds timeout) noexcept;
+
+		/**
+		* This method wait without limit until a display receives an event or another thread calls wake().
+		* @return std::vector<DisplayManagerEvent> & The events of all the displays
+		*/
+		inline const std::vector<ndm::DisplayManagerEvent> & wait_events() noexcept
+		{
+			return wait_events(std::chrono::milliseconds(-1));
+		}
+
+		/**
+		* This method wake up the thread waiting in wait_events(), it can be called from any thread.
+		* This method need to be implemented for each OS.
+		*/
+		void wake() noexcept;
+
+		/**
+		* This method return the displays of the manager.
+		* @return std::vector<Display *> & The displays
+		*/
+		inline const std::vector<ndm::Display *> & get_displays() const noexcept
+		{
+			return m_displays;
+		}
+
+		/**
+		* This method return true if the manager is loaded.
+		* @return bool If the manager is loaded or not
+		*/
+		inline bool is_loaded() const noexcept
+		{
+			return m_loaded;
+		}
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// NDM includes
+#include <ndm/display/display_event.hpp>
+
+namespace ndm
+{
+	class Display;
+
+	/**
+	* This structure represent one event reported by a DisplayManager, with the display that received it.
+	*/
+	struct DisplayManagerEvent
+	{
+		ndm::Display * display;
+		ndm::DisplayEvent event;
+	};
+}
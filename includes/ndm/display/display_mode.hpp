@@ -4,10 +4,13 @@ namespace ndm
 {
 	/*
 	* Enumeration that represent the display mode.
+	* FULLSCREEN is a borderless window covering the monitor in its current mode, so alt-tab is immediate.
+	* EXCLUSIVE_FULLSCREEN changes the mode of the monitor, the mode of the desktop is restored when the display loses the focus.
 	*/
 	enum class DisplayMode
 	{
 		FULLSCREEN,
-		WINDOWED
+		WINDOWED,
+		EXCLUSIVE_FULLSCREEN
 	};
-}
\ No newline at end of file
+}
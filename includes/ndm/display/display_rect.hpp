@@ -0,0 +1,19 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/**
+	* This structure represent a rectangle in the client area of a display, in pixels from the top-left corner.
+	* A rectangle with a null or negative size is empty.
+	*/
+	struct DisplayRect
+	{
+		std::int64_t x;
+		std::int64_t y;
+		std::int64_t width;
+		std::int64_t height;
+	};
+}
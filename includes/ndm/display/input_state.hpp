@@ -0,0 +1,287 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <type_traits>
+
+// NDM includes
+#include <ndm/display/display_event.hpp>
+
+namespace ndm
+{
+	/**
+	* This class is the state of the keyboard and the mouse of a display, updated from its events each time they are 
+	* caught, so the state of a key is read with a single bit lookup instead of searching the events.
+	* The keys are indexed by scan code (the position of the key, independent of the layout), the edges (pressed and 
+	* released) and the deltas of the mouse and the wheel only cover the events of the last call. A key repeated by the 
+	* system stays down, on X11 it can be released and pressed again in the same frame.
+	* The class is trivially copyable, a copy taken by the thread of the display can be handed to another thread.
+	*/
+	class InputState
+	{
+	public:
+
+		// Number of keys, the scan codes of Win32 use 9 bits with the extended keys and the key codes of X11 use 8 bits
+		static constexpr std::size_t key_count = 512;
+
+		// Number of buttons of the mouse, the buttons are numbered from 1
+		static constexpr std::size_t button_count = 8;
+
+	private:
+
+		static constexpr std::size_t word_count = key_count / 64;
+
+		// Packed bits of the keys
+		std::array<std::uint64_t, word_count> m_keys_down = {};
+		std::array<std::uint64_t, word_count> m_keys_pressed = {};
+		std::array<std::uint64_t, word_count> m_keys_released = {};
+
+		// Packed bits of the buttons
+		std::uint32_t m_buttons_down = 0;
+		std::uint32_t m_buttons_pressed = 0;
+		std::uint32_t m_buttons_released = 0;
+
+		// Mouse and wheel
+		std::int64_t m_mouse_x = 0;
+		std::int64_t m_mouse_y = 0;
+		std::int64_t m_mouse_delta_x = 0;
+		std::int64_t m_mouse_delta_y = 0;
+		std::int64_t m_wheel_x = 0;
+		std::int64_t m_wheel_y = 0;
+		std::uint64_t m_frame = 0;
+
+		// Bit of a key in a packed array
+		static inline bool test(const std::array<std::uint64_t, word_count> & bits, const std::size_t index) noexcept
+		{
+			return index < key_count && (bits[index >> 6] & (std::uint64_t(1) << (index & 63))) != 0;
+		}
+
+		// Bit of a button in a packed mask
+		static inline std::uint32_t button_bit(const std::uint32_t button) noexcept
+		{
+			return button > 0 && button <= button_count ? std::uint32_t(1) << (button - 1) : 0;
+		}
+
+	public:
+
+		/**
+		* This method return the index of a key from the scan code of its events.
+		* @param scan_code The scan code of a key event
+		* @return std::size_t The index of the key, lower than key_count
+		*/
+		static inline constexpr std::size_t get_key_index(const std::uint32_t scan_code) noexcept
+		{
+			// The extended keys of Win32 (0xE0 prefix) use the upper half of the keys
+			return static_cast<std::size_t>((scan_code & 0xFF) | ((scan_code & 0xFF00) != 0 ? 0x100 : 0));
+		}
+
+		/**
+		* This method start a new frame : the edges and the deltas of the previous events are cleared.
+		*/
+		inline void begin_frame() noexcept
+		{
+			m_keys_pressed.fill(0);
+			m_keys_released.fill(0);
+			m_buttons_pressed = 0;
+			m_buttons_released = 0;
+			m_mouse_delta_x = 0;
+			m_mouse_delta_y = 0;
+			m_wheel_x = 0;
+			m_wheel_y = 0;
+			m_frame++;
+		}
+
+		/**
+		* This method update the state with an event, the events that are not inputs are ignored.
+		* @param event The event of the display
+		*/
+		inline void apply(const ndm::DisplayEvent & event) noexcept
+		{
+			const std::size_t index = get_key_index(event.scan_code);
+			const std::size_t word = index >> 6;
+			const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+			switch (event.type)
+			{
+				case ndm::DisplayEventType::KEY_PRESSED:
+					if ((m_keys_down[word] & bit) == 0)
+						m_keys_pressed[word] |= bit;
+					m_keys_down[word] |= bit;
+					break;
+				case ndm::DisplayEventType::KEY_RELEASED:
+					if ((m_keys_down[word] & bit) != 0)
+						m_keys_released[word] |= bit;
+					m_keys_down[word] &= ~bit;
+					break;
+				case ndm::DisplayEventType::MOUSE_BUTTON_PRESSED:
+					m_buttons_pressed |= button_bit(event.key) & ~m_buttons_down;
+					m_buttons_down |= button_bit(event.key);
+					m_mouse_x = event.x;
+					m_mouse_y = event.y;
+					break;
+				case ndm::DisplayEventType::MOUSE_BUTTON_RELEASED:
+					m_buttons_released |= button_bit(event.key) & m_buttons_down;
+					m_buttons_down &= ~button_bit(event.key);
+					m_mouse_x = event.x;
+					m_mouse_y = event.y;
+					break;
+				case ndm::DisplayEventType::MOUSE_MOVED:
+					m_mouse_x = event.x;
+					m_mouse_y = event.y;
+					break;
+				case ndm::DisplayEventType::MOUSE_RAW_MOTION:
+					m_mouse_delta_x += event.x;
+					m_mouse_delta_y += event.y;
+					break;
+				case ndm::DisplayEventType::MOUSE_WHEEL:
+					m_wheel_x += event.x;
+					m_wheel_y += event.y;
+					break;
+				case ndm::DisplayEventType::FOCUS_LOST:
+					release_all();
+					break;
+				default:
+					break;
+			}
+		}
+
+		/**
+		* This method release all the keys and the buttons, usually when the display loses the focus and the releases are 
+		* sent to another window.
+		*/
+		inline void release_all() noexcept
+		{
+			for (std::size_t i = 0; i < word_count; i++)
+				m_keys_released[i] |= m_keys_down[i];
+			m_keys_down.fill(0);
+			m_buttons_released |= m_buttons_down;
+			m_buttons_down = 0;
+		}
+
+		/**
+		* This method return true if a key is down.
+		* @param scan_code The scan code of the key
+		* @return bool If the key is down
+		*/
+		inline bool is_key_down(const std::uint32_t scan_code) const noexcept
+		{
+			return test(m_keys_down, get_key_index(scan_code));
+		}
+
+		/**
+		* This method return true if a key has been pressed during the last frame.
+		* @param scan_code The scan code of the key
+		* @return bool If the key has been pressed
+		*/
+		inline bool was_key_pressed(const std::uint32_t scan_code) const noexcept
+		{
+			return test(m_keys_pressed, get_key_index(scan_code));
+		}
+
+		/**
+		* This method return true if a key has been released during the last frame.
+		* @param scan_code The scan code of the key
+		* @return bool If the key has been released
+		*/
+		inline bool was_key_released(const std::uint32_t scan_code) const noexcept
+		{
+			return test(m_keys_released, get_key_index(scan_code));
+		}
+
+		/**
+		* This method return true if a button of the mouse is down.
+		* @param button The button, from 1 to button_count
+		* @return bool If the button is down
+		*/
+		inline bool is_button_down(const std::uint32_t button) const noexcept
+		{
+			return (m_buttons_down & button_bit(button)) != 0;
+		}
+
+		/**
+		* This method return true if a button of the mouse has been pressed during the last frame.
+		* @param button The button, from 1 to button_count
+		* @return bool If the button has been pressed
+		*/
+		inline bool was_button_pressed(const std::uint32_t button) const noexcept
+		{
+			return (m_buttons_pressed & button_bit(button)) != 0;
+		}
+
+		/**
+		* This method return true if a button of the mouse has been released during the last frame.
+		* @param button The button, from 1 to button_count
+		* @return bool If the button has been released
+		*/
+		inline bool was_button_released(const std::uint32_t button) const noexcept
+		{
+			return (m_buttons_released & button_bit(button)) != 0;
+		}
+
+		/**
+		* This method return the last position of the cursor in the client area.
+		* @return std::int64_t The x position
+		*/
+		inline std::int64_t get_mouse_x() const noexcept
+		{
+			return m_mouse_x;
+		}
+
+		/**
+		* This method return the last position of the cursor in the client area.
+		* @return std::int64_t The y position
+		*/
+		inline std::int64_t get_mouse_y() const noexcept
+		{
+			return m_mouse_y;
+		}
+
+		/**
+		* This method return the raw motion of the mouse accumulated during the last frame.
+		* @return std::int64_t The horizontal motion in device units
+		*/
+		inline std::int64_t get_mouse_delta_x() const noexcept
+		{
+			return m_mouse_delta_x;
+		}
+
+		/**
+		* This method return the raw motion of the mouse accumulated during the last frame.
+		* @return std::int64_t The vertical motion in device units
+		*/
+		inline std::int64_t get_mouse_delta_y() const noexcept
+		{
+			return m_mouse_delta_y;
+		}
+
+		/**
+		* This method return the horizontal wheel delta accumulated during the last frame.
+		* @return std::int64_t The delta in MOUSE_WHEEL_STEP for one notch
+		*/
+		inline std::int64_t get_wheel_x() const noexcept
+		{
+			return m_wheel_x;
+		}
+
+		/**
+		* This method return the vertical wheel delta accumulated during the last frame.
+		* @return std::int64_t The delta in MOUSE_WHEEL_STEP for one notch
+		*/
+		inline std::int64_t get_wheel_y() const noexcept
+		{
+			return m_wheel_y;
+		}
+
+		/**
+		* This method return the number of frames since the creation of the state.
+		* @return std::uint64_t The frame of the state
+		*/
+		inline std::uint64_t get_frame() const noexcept
+		{
+			return m_frame;
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<ndm::InputState>, "The input state must be copyable with memcpy !");
+}
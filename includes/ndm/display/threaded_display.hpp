@@ -0,0 +1,392 @@
+#pragma once
+
+// STD includes
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <stdexcept>
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/display/display_commands.hpp>
+
+namespace ndm
+{
+	/**
+	* This class runs a display on its own event thread : the window is created and its events are read by the event 
+	* thread, so the modal loops of the OS (moving or resizing the window on Win32) and the window manager never block the 
+	* render thread. The events are received by the render thread through the lock-free ring of the display, and the 
+	* commands (geometry, title...) are sent back to the event thread through a lock-free commands ring.
+	* The methods of this class must be called by the render thread. The display returned by get_display() can be given to 
+	* a GLContext or a SoftwareFramebuffer once loaded, they follow the framebuffer size published by catch_events() on the 
+	* render thread. The render thread must not call the methods of that display itself (catch_events(), set_geometry()...), 
+	* they are called by the event thread.
+	*/
+	class ThreadedDisplay
+	{
+	private:
+
+		// Attributes
+		ndm::Display m_display;
+		ndm::DisplayEvents m_events;
+		ndm::DisplayCommands m_commands;
+		ndm::DisplayGeometry m_geometry;
+		std::uint32_t m_dpi;
+		ndm::InputState m_input_state;
+		std::thread m_thread;
+		std::atomic<bool> m_running;
+		std::atomic<std::uint64_t> m_failed_commands;
+		bool m_loaded;
+
+		/**
+		* This method apply a command on the event thread, a command that fails is counted and dropped.
+		* @param command The command to apply
+		*/
+		inline void apply_command(const ndm::DisplayCommand & command) noexcept
+		{
+			try {
+				switch (command.type)
+				{
+					case ndm::DisplayCommandType::SET_GEOMETRY:
+						m_display.set_geometry(command.x, command.y, command.width, command.height);
+						break;
+					case ndm::DisplayCommandType::SET_TITLE:
+						m_display.set_title(command.title.data());
+						break;
+					case ndm::DisplayCommandType::SET_VISIBLE:
+						m_display.set_visible(command.enabled);
+						break;
+					case ndm::DisplayCommandType::SET_RESIZABLE:
+						m_display.set_resizable_by_user(command.enabled);
+						break;
+					case ndm::DisplayCommandType::SET_SYNC_RESIZE:
+						m_display.set_sync_resize(command.enabled);
+						break;
+				}
+			} catch (...) {
+				m_failed_commands.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		* This method is the loop of the event thread, it creates the window, reads its events and applies the commands
+		* until the display is unloaded.
+		*/
+		inline void run(const std::string title, const std::uint64_t width, const std::uint64_t height, const bool visible, std::promise<void> & loaded) noexcept
+		{
+			NDM_TRACE_THREAD_NAME("ndm event thread");
+
+			try {
+				m_display.load(title, width, height, visible);
+			} catch (...) {
+				loaded.set_exception(std::current_exception());
+				return;
+			}
+
+			// The geometry is read before the render thread is released, it is only updated by the events after
+			m_geometry = m_display.get_geometry();
+			m_dpi = m_display.get_dpi();
+			loaded.set_value();
+
+			// The events are pushed in the ring of the display and popped by the render thread, they are never consumed here
+			ndm::DisplayCommand command = {};
+			while (m_running.load(std::memory_order_acquire) == true)
+			{
+				// A closed window has no event anymore, the thread only waits to be stopped
+				if (m_display.m_closed == true)
+				{
+					m_running.wait(true, std::memory_order_acquire);
+					break;
+				}
+
+				m_display.pump_events(std::chrono::milliseconds(-1));
+				while (m_commands.pop(command) == true)
+					apply_command(command);
+			}
+
+			m_display.unload();
+		}
+
+		/**
+		* This method send a command to the event thread and wake it up.
+		* @param command The command to send
+		*/
+		inline void send_command(const ndm::DisplayCommand & command)
+		{
+			if (m_loaded == false)
+				throw std::runtime_error("The display is not loaded !");
+
+			if (m_commands.push(command) == false)
+				throw std::runtime_error("The commands ring of the display is full !");
+
+			m_display.wake();
+		}
+
+	public:
+
+		// Constructor
+		inline ThreadedDisplay() :
+			m_display(),
+			m_events(),
+			m_commands(),
+			m_geometry(),
+			m_dpi(ndm::DEFAULT_DPI),
+			m_input_state(),
+			m_running(false),
+			m_failed_commands(0),
+			m_loaded(false)
+		{
+			// The render thread may wake the event thread until it has joined it
+			m_display.m_keep_wake_handle = true;
+			m_display.m_threaded = true;
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline ThreadedDisplay(ThreadedDisplay &) = delete;
+		inline ThreadedDisplay(const ThreadedDisplay &) = delete;
+
+		// Destructor
+		inline virtual ~ThreadedDisplay()
+		{
+			if (m_loaded == true)
+				unload();
+		}
+
+		/**
+		* This method start the event thread and wait until it has created the window.
+		* If the window cannot be created, the exception of the event thread is thrown.
+		* @param title The title of the display.
+		* @param width The width of the display on the screen.
+		* @param height The height of the display on the screen.
+		* @param visible The visibility of the display.
+		*/
+		inline void load(const std::string_view title, const std::uint64_t width, const std::uint64_t height, const bool visible)
+		{
+			if (m_loaded == true)
+				throw std::runtime_error("The display is already loaded !");
+
+			std::promise<void> loaded;
+			std::future<void> result = loaded.get_future();
+			m_running.store(true, std::memory_order_release);
+			m_thread = std::thread(&ndm::ThreadedDisplay::run, this, std::string(title), width, height, visible, std::ref(loaded));
+
+			try {
+				result.get();
+			} catch (...) {
+				m_running.store(false, std::memory_order_release);
+				m_thread.join();
+				m_display.release_wake_handle();
+				throw;
+			}
+
+			m_events.clear();
+			m_loaded = true;
+		}
+
+		/**
+		* This method stop the event thread, the window is destroyed by the event thread.
+		*/
+		inline void unload()
+		{
+			if (m_loaded == false)
+				throw std::runtime_error("The display is not loaded !");
+
+			// The event thread unloads the display but keeps its wake handle, so the handle is only released after the join
+			m_running.store(false, std::memory_order_release);
+			m_running.notify_one();
+			m_display.wake();
+			m_thread.join();
+			m_display.release_wake_handle();
+
+			m_loaded = false;
+		}
+
+		/**
+		* This method return all the events received by the event thread since the last call, the events of the previous 
+		* call are consumed. The method never waits for the OS.
+		* @return DisplayEvents& The events ring, iterable with a range-for
+		*/
+		inline ndm::DisplayEvents & catch_events() noexcept
+		{
+			m_events.clear();
+			m_input_state.begin_frame();
+
+			// The resizes counted before the events are moved are seen by the render thread, the next present acknowledges them
+			m_display.m_resize_seen = m_display.m_resize_count.load(std::memory_order_acquire);
+
+			// The events are moved from the ring filled by the event thread, and the geometry seen by the render thread follows them
+			ndm::DisplayEvent event = {};
+			while (m_display.m_events.pop(event) == true)
+			{
+				switch (event.type)
+				{
+					case ndm::DisplayEventType::RESIZED:
+					case ndm::DisplayEventType::MAXIMIZED:
+						m_geometry.client_width = event.width;
+						m_geometry.client_height = event.height;
+						break;
+					case ndm::DisplayEventType::MOVED:
+						m_geometry.x = event.x;
+						m_geometry.y = event.y;
+						break;
+					case ndm::DisplayEventType::SCALE_CHANGED:
+						m_dpi = static_cast<std::uint32_t>(event.x);
+						m_geometry.client_width = event.width;
+						m_geometry.client_height = event.height;
+						break;
+					default:
+						break;
+				}
+				m_input_state.apply(event);
+				m_events.push(event);
+			}
+			m_events.coalesce(ndm::DisplayEventType::RESIZED);
+
+			// The renderers of the display follow the size seen by the render thread
+			m_display.m_framebuffer_width = m_geometry.client_width;
+			m_display.m_framebuffer_height = m_geometry.client_height;
+
+			return m_events;
+		}
+
+		/**
+		* This method ask the event thread to set the position and the outer size of the display.
+		* @param x The x position
+		* @param y The y position
+		* @param width The width of the display
+		* @param height The height of the display
+		*/
+		inline void set_geometry(const std::int64_t x, const std::int64_t y, const std::uint64_t width, const std::uint64_t height)
+		{
+			send_command(ndm::DisplayCommand { ndm::DisplayCommandType::SET_GEOMETRY, x, y, width, height, false, {} });
+		}
+
+		/**
+		* This method ask the event thread to set the title of the display, the title is truncated to 255 bytes.
+		* @param title The new title of the display.
+		*/
+		inline void set_title(const std::string_view title)
+		{
+			ndm::DisplayCommand command { ndm::DisplayCommandType::SET_TITLE, 0, 0, 0, 0, false, {} };
+			const std::size_t size = std::min(title.size(), command.title.size() - 1);
+			std::copy_n(title.data(), size, command.title.data());
+			command.title[size] = '\0';
+			send_command(command);
+		}
+
+		/**
+		* This method ask the event thread to set the visibility of the display.
+		* @param visible The visibility of the display.
+		*/
+		inline void set_visible(const bool visible)
+		{
+			send_command(ndm::DisplayCommand { ndm::DisplayCommandType::SET_VISIBLE, 0, 0, 0, 0, visible, {} });
+		}
+
+		/**
+		* This method ask the event thread to set the display resizable by the user.
+		* @param resizable If the display is resizable.
+		*/
+		inline void set_resizable_by_user(const bool resizable)
+		{
+			send_command(ndm::DisplayCommand { ndm::DisplayCommandType::SET_RESIZABLE, 0, 0, 0, 0, resizable, {} });
+		}
+
+		/**
+		* This method ask the event thread to enable the synchronous resize, the frames presented by the render thread are
+		* waited for by the window manager (see Display::set_sync_resize()).
+		* @param enabled If the resize is synchronous.
+		*/
+		inline void set_sync_resize(const bool enabled)
+		{
+			send_command(ndm::DisplayCommand { ndm::DisplayCommandType::SET_SYNC_RESIZE, 0, 0, 0, 0, enabled, {} });
+		}
+
+		/**
+		* This method return the geometry of the display known by the render thread, updated by the events received by 
+		* catch_events(). The outer size is the size at the creation of the window.
+		* @return DisplayGeometry & The geometry structure
+		*/
+		inline const ndm::DisplayGeometry & get_geometry() const noexcept
+		{
+			return m_geometry;
+		}
+
+		/**
+		* This method return the size of the framebuffer known by the render thread, the client size in pixels.
+		* @return std::int64_t The framebuffer width of the display
+		*/
+		inline std::int64_t get_framebuffer_width() const noexcept
+		{
+			return m_geometry.client_width;
+		}
+
+		/**
+		* This method return the size of the framebuffer known by the render thread, the client size in pixels.
+		* @return std::int64_t The framebuffer height of the display
+		*/
+		inline std::int64_t get_framebuffer_height() const noexcept
+		{
+			return m_geometry.client_height;
+		}
+
+		/**
+		* This method return the DPI of the display known by the render thread, updated by the SCALE_CHANGED events.
+		* @return std::uint32_t The DPI of the display, DEFAULT_DPI for a scale of 1
+		*/
+		inline std::uint32_t get_dpi() const noexcept
+		{
+			return m_dpi;
+		}
+
+		/**
+		* This method return the scale of the content of the display known by the render thread.
+		* @return float The content scale, 1 for DEFAULT_DPI
+		*/
+		inline float get_content_scale() const noexcept
+		{
+			return static_cast<float>(m_dpi) / static_cast<float>(ndm::DEFAULT_DPI);
+		}
+
+		/**
+		* This method return the state of the keyboard and the mouse, updated by the last call to catch_events().
+		* @return InputState & The input state
+		*/
+		inline const ndm::InputState & get_input_state() const noexcept
+		{
+			return m_input_state;
+		}
+
+		/**
+		* This method return the number of commands that failed on the event thread.
+		* @return std::uint64_t The number of failed commands
+		*/
+		inline std::uint64_t get_failed_command_count() const noexcept
+		{
+			return m_failed_commands.load(std::memory_order_relaxed);
+		}
+
+		/**
+		* This method return the display run by the event thread, to create a GLContext.
+		* @return Display & The display
+		*/
+		inline ndm::Display & get_display() noexcept
+		{
+			return m_display;
+		}
+
+		/**
+		* This method return true if the display is loaded.
+		* @return bool If the display is loaded or not
+		*/
+		inline bool is_loaded() const noexcept
+		{
+			return m_loaded;
+		}
+	};
+}
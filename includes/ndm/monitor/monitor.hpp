@@ -5,30 +5,63 @@
 #include <string_view>
 #include <vector>
 #include <tuple>
+#include <cstring>
+#include <cstdint>
 
-// Win32 NDM includes
+// NDM includes
 #include <ndm/os/win32_functions.hpp>
+#include <ndm/os/x11_functions.hpp>
 #include <ndm/monitor/monitor_capabilities.hpp>
+#include <ndm/monitor/monitor_mode_table.hpp>
+#include <ndm/trace/trace.hpp>
 
 namespace ndm
 {
+    class MonitorRegistry;
+
     class Monitor
     {
     private:
 
+        // The registry fills the monitors
+        friend class ndm::MonitorRegistry;
+
+        // Attributes, the modes are sorted and indexed once when the monitors are enumerated
+        ndm::MonitorModeTable m_modes;
+        std::int64_t m_x;
+        std::int64_t m_y;
+
         #if defined(_WIN32) || defined(_WIN64)
 
         // Win32 native monitor attributes
         unsigned long m_display_index;
         DISPLAY_DEVICEA m_display_device;
-        std::vector<DEVMODEA> m_device_modes;
+
+        #endif
+
+        #if defined(__linux__) && !defined(NDM_HEADLESS)
+
+        // X11 native monitor attributes, a monitor of XRandR can span several outputs
+        std::string m_x11_name;
+        XID m_x11_output;
+        bool m_x11_primary;
 
         #endif
 
         // Private default constructor
-        inline Monitor()
+        inline Monitor() :
+            m_modes(),
+            m_x(0),
+            m_y(0)
         {
+            #if defined(_WIN32) || defined(_WIN64)
             std::memset(&m_display_device, 0, sizeof(DISPLAY_DEVICEA));
+            #endif
+
+            #if defined(__linux__) && !defined(NDM_HEADLESS)
+            m_x11_output = 0;
+            m_x11_primary = false;
+            #endif
         }
 
     public:
@@ -40,27 +73,109 @@ namespace ndm
 
         std::string get_name() const;
 
-        std::vector<ndm::MonitorCapabilities> get_all_capabilities() const;
+        /**
+        * This method return the capabilities of all the modes of the monitor, sorted by resolution and refresh rate.
+        * @return std::vector<MonitorCapabilities> The modes at the position of the monitor
+        */
+        inline std::vector<ndm::MonitorCapabilities> get_all_capabilities() const
+        {
+            std::vector<ndm::MonitorCapabilities> monitor_capabilities;
+            monitor_capabilities.reserve(m_modes.size());
+
+            for(std::size_t i = 0; i < m_modes.size(); i++)
+            {
+                const ndm::MonitorMode mode = m_modes.get_mode(i);
+                monitor_capabilities.push_back(ndm::MonitorCapabilities { mode.width, mode.height, static_cast<unsigned long>(m_x), static_cast<unsigned long>(m_y), mode.refresh_rate });
+            }
+
+            return monitor_capabilities;
+        }
 
-        std::tuple<unsigned long, unsigned long> get_max_size() const;
+        /**
+        * This method return the size of the mode with the most pixels.
+        * @return std::tuple<unsigned long, unsigned long> The width and the height
+        */
+        inline std::tuple<unsigned long, unsigned long> get_max_size() const noexcept
+        {
+            const ndm::MonitorMode mode = m_modes.get_largest_mode();
+            return std::tuple<unsigned long, unsigned long>(mode.width, mode.height);
+        }
 
-        std::tuple<unsigned long, unsigned long> get_min_size() const;
+        /**
+        * This method return the size of the mode with the least pixels.
+        * @return std::tuple<unsigned long, unsigned long> The width and the height
+        */
+        inline std::tuple<unsigned long, unsigned long> get_min_size() const noexcept
+        {
+            const ndm::MonitorMode mode = m_modes.get_smallest_mode();
+            return std::tuple<unsigned long, unsigned long>(mode.width, mode.height);
+        }
 
-        std::tuple<unsigned long, unsigned long> get_min_position() const;
+        /**
+        * This method return the position of the top-left corner of the monitor on the desktop.
+        * @return std::tuple<unsigned long, unsigned long> The x and y position
+        */
+        inline std::tuple<unsigned long, unsigned long> get_min_position() const noexcept
+        {
+            return std::tuple<unsigned long, unsigned long>(static_cast<unsigned long>(m_x), static_cast<unsigned long>(m_y));
+        }
 
-        unsigned long get_max_refresh_rate() const;
+        /**
+        * This method return the highest refresh rate of the modes.
+        * @return unsigned long The refresh rate
+        */
+        inline unsigned long get_max_refresh_rate() const noexcept
+        {
+            return m_modes.get_max_refresh_rate();
+        }
 
-        unsigned long get_min_refresh_rate() const;
+        /**
+        * This method return the lowest refresh rate of the modes.
+        * @return unsigned long The refresh rate
+        */
+        inline unsigned long get_min_refresh_rate() const noexcept
+        {
+            return m_modes.get_min_refresh_rate();
+        }
 
         bool is_primary() const;
 
+        /**
+        * This method return the capabilities of the mode closest to a size and a refresh rate, in O(log n).
+        * If the monitor has no mode, the capabilities are null.
+        * @param width The requested width
+        * @param height The requested height
+        * @param refresh_rate The requested refresh rate
+        * @return MonitorCapabilities The closest mode at the position of the monitor
+        */
+        inline ndm::MonitorCapabilities get_closest_capabilities(const unsigned long width, const unsigned long height, const unsigned long refresh_rate) const noexcept
+        {
+            const std::size_t index = m_modes.find_closest(static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), static_cast<std::uint32_t>(refresh_rate));
+            if (index == ndm::MonitorModeTable::npos)
+                return ndm::MonitorCapabilities {};
+
+            const ndm::MonitorMode mode = m_modes.get_mode(index);
+            return ndm::MonitorCapabilities { mode.width, mode.height, static_cast<unsigned long>(m_x), static_cast<unsigned long>(m_y), mode.refresh_rate };
+        }
+
+        /**
+        * This method return the table of the modes of the monitor.
+        * @return MonitorModeTable & The modes
+        */
+        inline const ndm::MonitorModeTable & get_modes() const noexcept
+        {
+            return m_modes;
+        }
+
         #if defined(_WIN32) || defined(_WIN64)
         const DISPLAY_DEVICEA & get_win32_display_device() const;
 
-        const std::vector<DEVMODEA> & get_win32_device_modes() const;
-
         unsigned long get_win32_display_index() const;
         #endif
 
+        #if defined(__linux__) && !defined(NDM_HEADLESS)
+        XID get_x11_output() const;
+        #endif
+
     };
 }
\ No newline at end of file
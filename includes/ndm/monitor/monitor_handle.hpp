@@ -0,0 +1,20 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/**
+	* This structure identify a monitor of a MonitorRegistry. The handle stays valid while the monitor is connected, even
+	* when the registry is refreshed, and becomes invalid when the monitor is removed (the generation of its slot changes).
+	* A default handle is never valid.
+	*/
+	struct MonitorHandle
+	{
+		std::uint32_t index = 0;
+		std::uint32_t generation = 0;
+
+		inline bool operator==(const MonitorHandle &) const noexcept = default;
+	};
+}
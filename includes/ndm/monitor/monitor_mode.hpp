@@ -0,0 +1,17 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+
+namespace ndm
+{
+	/**
+	* This structure describe a video mode supported by a monitor.
+	*/
+	struct MonitorMode
+	{
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t refresh_rate;
+	};
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// NDM includes
+#include <ndm/monitor/monitor_mode.hpp>
+
+namespace ndm
+{
+	/**
+	* This class is the table of the video modes of a monitor, built once when the monitors are enumerated.
+	* The modes are deduplicated (the OS lists a mode for each color depth and scaling) and sorted by resolution and then by
+	* refresh rate, in separate arrays of widths, heights and refresh rates, so the modes of a resolution are contiguous.
+	* A second table indexes the resolutions by number of pixels, so the closest mode of a size is found in O(log n).
+	* The aggregates (largest, smallest, refresh rates) are computed when the table is built.
+	*/
+	class MonitorModeTable
+	{
+	public:
+
+		// Index returned when there is no mode
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	private:
+
+		// Modes sorted by width, height and refresh rate
+		std::vector<std::uint32_t> m_widths;
+		std::vector<std::uint32_t> m_heights;
+		std::vector<std::uint32_t> m_refresh_rates;
+
+		// Resolutions sorted by number of pixels, with the range of their modes
+		std::vector<std::uint64_t> m_resolution_areas;
+		std::vector<std::uint32_t> m_resolution_first_modes;
+		std::vector<std::uint32_t> m_resolution_mode_counts;
+
+		// Aggregates
+		std::size_t m_largest_mode;
+		std::size_t m_smallest_mode;
+		std::uint32_t m_min_refresh_rate;
+		std::uint32_t m_max_refresh_rate;
+
+		// Distance between two values without overflow
+		static inline std::uint64_t distance(const std::uint64_t a, const std::uint64_t b) noexcept
+		{
+			return a > b ? a - b : b - a;
+		}
+
+		// Find the mode of a resolution with the closest refresh rate
+		inline std::size_t find_closest_refresh_rate(const std::size_t resolution, const std::uint32_t refresh_rate) const noexcept
+		{
+			const auto first = m_refresh_rates.begin() + m_resolution_first_modes[resolution];
+			const auto last = first + m_resolution_mode_counts[resolution];
+			const auto found = std::lower_bound(first, last, refresh_rate);
+
+			// The closest is the first rate that is not lower, or the one just before
+			if (found == last)
+				return static_cast<std::size_t>((last - 1) - m_refresh_rates.begin());
+			if (found == first || *found - refresh_rate <= refresh_rate - *(found - 1))
+				return static_cast<std::size_t>(found - m_refresh_rates.begin());
+			return static_cast<std::size_t>((found - 1) - m_refresh_rates.begin());
+		}
+
+	public:
+
+		// Constructor
+		inline MonitorModeTable() noexcept :
+			m_largest_mode(npos),
+			m_smallest_mode(npos),
+			m_min_refresh_rate(0),
+			m_max_refresh_rate(0)
+		{
+		}
+
+		/**
+		* This method build the table from the modes listed by the OS, the modes can be in any order and duplicated.
+		* @param modes The modes of the monitor.
+		*/
+		inline void build(std::vector<ndm::MonitorMode> modes)
+		{
+			// Sort and deduplicate the modes
+			std::sort(modes.begin(), modes.end(), [](const ndm::MonitorMode & a, const ndm::MonitorMode & b)
+			{
+				if (a.width != b.width) return a.width < b.width;
+				if (a.height != b.height) return a.height < b.height;
+				return a.refresh_rate < b.refresh_rate;
+			});
+
+			modes.erase(std::unique(modes.begin(), modes.end(), [](const ndm::MonitorMode & a, const ndm::MonitorMode & b)
+			{
+				return a.width == b.width && a.height == b.height && a.refresh_rate == b.refresh_rate;
+			}), modes.end());
+
+			// Store the modes in separate arrays
+			m_widths.resize(modes.size());
+			m_heights.resize(modes.size());
+			m_refresh_rates.resize(modes.size());
+			for (std::size_t i = 0; i < modes.size(); i++)
+			{
+				m_widths[i] = modes[i].width;
+				m_heights[i] = modes[i].height;
+				m_refresh_rates[i] = modes[i].refresh_rate;
+			}
+
+			// Collect the resolutions, each one is the range of its modes
+			std::vector<std::uint32_t> resolutions;
+			for (std::size_t i = 0; i < modes.size(); i++)
+			{
+				if (i == 0 || m_widths[i] != m_widths[i - 1] || m_heights[i] != m_heights[i - 1])
+					resolutions.push_back(static_cast<std::uint32_t>(i));
+			}
+
+			// Index the resolutions by number of pixels, the widest first when two resolutions have the same number of pixels
+			std::sort(resolutions.begin(), resolutions.end(), [this](const std::uint32_t a, const std::uint32_t b)
+			{
+				const std::uint64_t area_a = static_cast<std::uint64_t>(m_widths[a]) * m_heights[a];
+				const std::uint64_t area_b = static_cast<std::uint64_t>(m_widths[b]) * m_heights[b];
+				return area_a != area_b ? area_a < area_b : m_widths[a] > m_widths[b];
+			});
+
+			m_resolution_areas.resize(resolutions.size());
+			m_resolution_first_modes.resize(resolutions.size());
+			m_resolution_mode_counts.resize(resolutions.size());
+			for (std::size_t i = 0; i < resolutions.size(); i++)
+			{
+				const std::uint32_t first = resolutions[i];
+				std::uint32_t last = first;
+				while (last < m_widths.size() && m_widths[last] == m_widths[first] && m_heights[last] == m_heights[first])
+					last++;
+
+				m_resolution_areas[i] = static_cast<std::uint64_t>(m_widths[first]) * m_heights[first];
+				m_resolution_first_modes[i] = first;
+				m_resolution_mode_counts[i] = last - first;
+			}
+
+			// Aggregates, the largest and the smallest modes use the highest refresh rate of their resolution
+			m_largest_mode = npos;
+			m_smallest_mode = npos;
+			m_min_refresh_rate = 0;
+			m_max_refresh_rate = 0;
+			if (modes.empty() == true)
+				return;
+
+			m_largest_mode = m_resolution_first_modes.back() + m_resolution_mode_counts.back() - 1;
+			m_smallest_mode = m_resolution_first_modes.front() + m_resolution_mode_counts.front() - 1;
+			m_min_refresh_rate = *std::min_element(m_refresh_rates.begin(), m_refresh_rates.end());
+			m_max_refresh_rate = *std::max_element(m_refresh_rates.begin(), m_refresh_rates.end());
+		}
+
+		/**
+		* This method find the mode closest to a size and a refresh rate. The resolution with the closest number of pixels is
+		* chosen first (the exact resolution if it exists), and then its closest refresh rate.
+		* @param width The requested width
+		* @param height The requested height
+		* @param refresh_rate The requested refresh rate
+		* @return std::size_t The index of the mode, npos if the table is empty
+		*/
+		inline std::size_t find_closest(const std::uint32_t width, const std::uint32_t height, const std::uint32_t refresh_rate) const noexcept
+		{
+			if (m_resolution_areas.empty() == true)
+				return npos;
+
+			// The candidates are the resolutions around the requested number of pixels, several resolutions can have the same
+			// number of pixels so all of them are compared to find the exact one
+			const std::uint64_t area = static_cast<std::uint64_t>(width) * height;
+			const auto found = std::lower_bound(m_resolution_areas.begin(), m_resolution_areas.end(), area);
+			std::size_t begin = static_cast<std::size_t>(found - m_resolution_areas.begin());
+			if (begin > 0)
+				begin--;
+			while (begin > 0 && m_resolution_areas[begin - 1] == m_resolution_areas[begin])
+				begin--;
+
+			std::size_t best = npos;
+			std::uint64_t best_area_distance = 0;
+			std::uint64_t best_shape_distance = 0;
+			for (std::size_t i = begin; i < m_resolution_areas.size(); i++)
+			{
+				const std::uint64_t area_distance = distance(m_resolution_areas[i], area);
+
+				// The areas are sorted, so the next resolutions are further
+				if (best != npos && m_resolution_areas[i] > area && area_distance > best_area_distance)
+					break;
+
+				const std::uint32_t mode = m_resolution_first_modes[i];
+				const std::uint64_t shape_distance = distance(m_widths[mode], width) + distance(m_heights[mode], height);
+				if (best == npos || area_distance < best_area_distance || (area_distance == best_area_distance && shape_distance < best_shape_distance))
+				{
+					best = i;
+					best_area_distance = area_distance;
+					best_shape_distance = shape_distance;
+				}
+			}
+
+			return find_closest_refresh_rate(best, refresh_rate);
+		}
+
+		/**
+		* This method return the mode at an index.
+		* @param index The index of the mode, lower than size()
+		* @return MonitorMode The mode
+		*/
+		inline ndm::MonitorMode get_mode(const std::size_t index) const noexcept
+		{
+			return { m_widths[index], m_heights[index], m_refresh_rates[index] };
+		}
+
+		/**
+		* This method return the mode with the most pixels, and the highest refresh rate of its resolution.
+		* @return MonitorMode The largest mode, null if the table is empty
+		*/
+		inline ndm::MonitorMode get_largest_mode() const noexcept
+		{
+			return m_largest_mode != npos ? get_mode(m_largest_mode) : ndm::MonitorMode { 0, 0, 0 };
+		}
+
+		/**
+		* This method return the mode with the least pixels, and the highest refresh rate of its resolution.
+		* @return MonitorMode The smallest mode, null if the table is empty
+		*/
+		inline ndm::MonitorMode get_smallest_mode() const noexcept
+		{
+			return m_smallest_mode != npos ? get_mode(m_smallest_mode) : ndm::MonitorMode { 0, 0, 0 };
+		}
+
+		/**
+		* This method return the lowest refresh rate of all the modes.
+		* @return std::uint32_t The refresh rate, 0 if the table is empty
+		*/
+		inline std::uint32_t get_min_refresh_rate() const noexcept
+		{
+			return m_min_refresh_rate;
+		}
+
+		/**
+		* This method return the highest refresh rate of all the modes.
+		* @return std::uint32_t The refresh rate, 0 if the table is empty
+		*/
+		inline std::uint32_t get_max_refresh_rate() const noexcept
+		{
+			return m_max_refresh_rate;
+		}
+
+		/**
+		* This method return the number of modes.
+		* @return std::size_t The number of modes
+		*/
+		inline std::size_t size() const noexcept
+		{
+			return m_widths.size();
+		}
+
+		/**
+		* This method return the number of distinct resolutions.
+		* @return std::size_t The number of resolutions
+		*/
+		inline std::size_t get_resolution_count() const noexcept
+		{
+			return m_resolution_areas.size();
+		}
+
+		/**
+		* This method return true if there is no mode.
+		* @return bool If the table is empty
+		*/
+		inline bool empty() const noexcept
+		{
+			return m_widths.empty();
+		}
+	};
+}
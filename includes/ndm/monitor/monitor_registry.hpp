@@ -0,0 +1,204 @@
+#pragma once
+
+// STD includes
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+// NDM includes
+#include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_handle.hpp>
+
+namespace ndm
+{
+	/**
+	* This class keep the monitors between two enumerations, usually refreshed when the display receives MONITORS_CHANGED.
+	* A refresh only reads the cheap state of each monitor (device, position, current mode), the modes are enumerated again
+	* only for the monitors that are new or replaced, so docking a laptop doesn't enumerate the modes of every monitor.
+	* The monitors are never copied : they are stored in slots and given by handle, and the generation counter changes each
+	* time a refresh finds a difference, so the callers can skip their work when it didn't change.
+	*/
+	class MonitorRegistry
+	{
+	private:
+
+		// State compared at each refresh to know if a monitor changed
+		struct MonitorState
+		{
+			std::string id;
+			std::int64_t x = 0;
+			std::int64_t y = 0;
+			std::int64_t width = 0;
+			std::int64_t height = 0;
+			std::uint32_t refresh_rate = 0;
+			std::uint32_t flags = 0;
+
+			inline bool operator==(const MonitorState &) const = default;
+		};
+
+		// A monitor and its state, the slot is reused by another monitor once released
+		struct Slot
+		{
+			ndm::Monitor monitor;
+			MonitorState state;
+			std::string key;
+			std::uint32_t generation = 1;
+			bool used = false;
+			bool seen = false;
+		};
+
+		// Attributes, there are only a few monitors so the slots are searched linearly
+		std::vector<Slot> m_slots;
+		std::vector<ndm::MonitorHandle> m_handles;
+		std::uint64_t m_generation;
+
+		#if defined(__linux__) && !defined(NDM_HEADLESS)
+		// Time of the last change of the screen configuration, the modes of the screen only change with it
+		unsigned long m_x11_config_timestamp;
+		#endif
+
+		/**
+		* This method prepare a refresh, no monitor is seen yet.
+		*/
+		inline void begin_refresh() noexcept
+		{
+			m_handles.clear();
+			for (Slot & slot : m_slots)
+				slot.seen = false;
+		}
+
+		/**
+		* This method return the slot of a monitor seen by the refresh, a free slot is used if the monitor is new.
+		* @param key The identifier of the monitor given by the OS
+		* @param inserted Set to true if the monitor is new
+		* @return Slot & The slot of the monitor
+		*/
+		inline Slot & find_slot(const std::string_view key, bool & inserted)
+		{
+			std::size_t index = m_slots.size();
+			std::size_t free_index = m_slots.size();
+			for (std::size_t i = 0; i < m_slots.size(); i++)
+			{
+				if (m_slots[i].used == true && m_slots[i].key == key)
+				{
+					index = i;
+					break;
+				}
+				if (m_slots[i].used == false && free_index == m_slots.size())
+					free_index = i;
+			}
+
+			inserted = index == m_slots.size();
+			if (inserted == true)
+			{
+				if (free_index == m_slots.size())
+					m_slots.emplace_back();
+				index = free_index;
+
+				m_slots[index].key = key;
+				m_slots[index].state = MonitorState {};
+				m_slots[index].used = true;
+			}
+
+			// The handles are listed in the order of the OS
+			Slot & slot = m_slots[index];
+			slot.seen = true;
+			m_handles.push_back(ndm::MonitorHandle { static_cast<std::uint32_t>(index), slot.generation });
+			return slot;
+		}
+
+		/**
+		* This method release the slots of the monitors that were not seen by the refresh, their handles become invalid.
+		* @return bool If a monitor was removed
+		*/
+		inline bool release_unseen_slots()
+		{
+			bool removed = false;
+			for (Slot & slot : m_slots)
+			{
+				if (slot.used == true && slot.seen == false)
+				{
+					slot.monitor = ndm::Monitor();
+					slot.key.clear();
+					slot.used = false;
+					slot.generation++;
+					removed = true;
+				}
+			}
+			return removed;
+		}
+
+	public:
+
+		// Constructor
+		inline MonitorRegistry() :
+			m_generation(0)
+		{
+			#if defined(__linux__) && !defined(NDM_HEADLESS)
+			m_x11_config_timestamp = 0;
+			#endif
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline MonitorRegistry(MonitorRegistry &) = delete;
+		inline MonitorRegistry(const MonitorRegistry &) = delete;
+
+		// Destructor
+		inline virtual ~MonitorRegistry() = default;
+
+		/**
+		* This method enumerate the monitors again and update the ones that changed. The handles of the removed monitors
+		* become invalid, the others stay valid.
+		* If the monitors cannot be enumerated, an exception is thrown.
+		* This method need to be implemented for each OS.
+		* @return bool If a monitor was added, removed or changed
+		*/
+		bool refresh();
+
+		/**
+		* This method return the generation of the monitors, incremented by each refresh that found a change.
+		* @return std::uint64_t The generation, 0 before the first refresh
+		*/
+		inline std::uint64_t get_generation() const noexcept
+		{
+			return m_generation;
+		}
+
+		/**
+		* This method return the handles of the connected monitors, in the order of the OS.
+		* @return std::vector<MonitorHandle> & The handles
+		*/
+		inline const std::vector<ndm::MonitorHandle> & get_handles() const noexcept
+		{
+			return m_handles;
+		}
+
+		/**
+		* This method return true if the handle is a connected monitor.
+		* @param handle The handle of the monitor
+		* @return bool If the handle is valid
+		*/
+		inline bool is_valid(const ndm::MonitorHandle handle) const noexcept
+		{
+			return handle.index < m_slots.size() && m_slots[handle.index].used == true && m_slots[handle.index].generation == handle.generation;
+		}
+
+		/**
+		* This method return the monitor of a handle. The reference is valid until the next refresh.
+		* If the handle is not valid, an exception is thrown.
+		* @param handle The handle of the monitor
+		* @return Monitor & The monitor
+		*/
+		inline const ndm::Monitor & get_monitor(const ndm::MonitorHandle handle) const
+		{
+			if (is_valid(handle) == false)
+				throw std::runtime_error("The monitor handle is not valid !");
+
+			return m_slots[handle.index].monitor;
+		}
+	};
+}
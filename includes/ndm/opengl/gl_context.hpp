@@ -5,12 +5,22 @@
 #include <string_view>
 #include <vector>
 #include <tuple>
+#include <chrono>
+#include <stdexcept>
 
 // Win32 NDM includes
 #include <ndm/opengl/gl_context_profile.hpp>
 #include <ndm/opengl/gl_context_params.hpp>
+#include <ndm/opengl/gl_frame_timer.hpp>
+#include <ndm/opengl/gl_render_scale_controller.hpp>
+#include <ndm/opengl/gl_swap_control.hpp>
+#include <ndm/opengl/gl_extensions.hpp>
+#include <ndm/opengl/gl_framebuffer_image.hpp>
 #include <ndm/display/display.hpp>
+#include <ndm/display/damage_region.hpp>
 #include <ndm/os/win32_functions.hpp>
+#include <ndm/os/glx_functions.hpp>
+#include <ndm/os/egl_functions.hpp>
 
 namespace ndm
 {
@@ -21,25 +31,79 @@ namespace ndm
 		// Attributes
         ndm::Display * m_display_ptr;
 		bool m_loaded;
+		ndm::GLFrameTimer m_frame_timer;
+		ndm::GLRenderScaleController m_render_scale;
+		ndm::GLSwapControl m_swap_control;
+		std::int32_t m_swap_interval;
 
 		#if defined(_WIN32) || defined(_WIN64)
 		// Win32 native display attributes
 		HGLRC m_gl_device_context;
+		HDC m_device_context;
+		HWND m_headless_handle;
+		#endif
+
+		#if defined(__linux__) && !defined(NDM_HEADLESS)
+		// GLX native context attributes
+		GLXContext m_glx_context;
+		::Display * m_glx_display;
+		GLXDrawable m_glx_drawable;
+		GLXPbuffer m_glx_pbuffer;
+		bool m_glx_owns_display;
+		bool m_glx_oml_sync_control;
+		bool m_glx_ext_swap_control;
+		bool m_glx_mesa_swap_control;
+		bool m_glx_mesa_copy_sub_buffer;
+		#endif
+
+		#if defined(__linux__) && defined(NDM_HEADLESS)
+		// EGL headless context attributes, the context renders to a pbuffer that follows the size of the display
+		EGLDisplay m_egl_display;
+		EGLConfig m_egl_config;
+		EGLContext m_egl_context;
+		EGLSurface m_egl_surface;
+		EGLint m_egl_surface_width;
+		EGLint m_egl_surface_height;
+		bool m_egl_owns_display;
+		bool m_egl_swap_buffers_with_damage;
+
+		/**
+		* This method recreate the pbuffer when the client size of the display changed, the content of the pbuffer is lost.
+		*/
+		void resize_egl_surface();
 		#endif
 
     public:
 
-        // No default constructor
-        inline GLContext() = delete;
+        /**
+        * Constructor of a headless context : it is not bound to a display and renders to a small offscreen surface.
+        * It is meant for worker threads that upload resources for a context given as GLContextParams::shared_context.
+        */
+        inline GLContext() :
+            m_display_ptr(nullptr),
+            m_loaded(false),
+            m_swap_control(),
+            m_swap_interval(0)
+        {
+		}
 
         // Constructor
         inline GLContext(ndm::Display * display_ptr) :
-            m_display_ptr(display_ptr)
+            m_display_ptr(display_ptr),
+            m_loaded(false),
+            m_swap_control(),
+            m_swap_interval(1)
         {
 			if(m_display_ptr == nullptr)
-				throw std::exception("Can't instantiate a GLContext with a null display !");
+				throw std::runtime_error("Can't instantiate a GLContext with a null display !");
 		}
 
+        /**
+        * No copy constructors
+        */
+        inline GLContext(GLContext &) = delete;
+        inline GLContext(const GLContext &) = delete;
+
         // Destructor
         inline virtual ~GLContext() = default;
         
@@ -52,17 +116,172 @@ namespace ndm
 		void load(const ndm::GLContextParams & params);
 		
 		/**
-		* This method unload and delete the current OpenGL context.
+		* This method unload and delete the OpenGL context, if the context is current on the calling thread, it is released first.
 		* This method need to be implemented for each OS.
 		*/
 		void unload();
 
+		/**
+		* This method make the OpenGL context current on the calling thread, a context can only be current on one thread at a time.
+		* This method need to be implemented for each OS.
+		*/
+		void make_current();
+
+		/**
+		* This method release the OpenGL context current on the calling thread, so it can be made current on another thread.
+		* This method need to be implemented for each OS.
+		*/
+		void release_current();
+
+		/**
+		* This method return true if the context is not bound to a display.
+		* @return bool If the context is headless
+		*/
+		inline bool is_headless() const noexcept
+		{
+			return m_display_ptr == nullptr;
+		}
+
+		/**
+		* This method return true if the context is loaded.
+		* @return bool If the context is loaded or not
+		*/
+		inline bool is_loaded() const noexcept
+		{
+			return m_loaded;
+		}
+
 		/**
 		* This method swap the back and front buffer of the display if the display use double buffering.
+		* A headless context has no display to present to, so an exception is thrown.
+		* This method need to be implemented for each OS.
+		*/
+		void swap_front_and_back();
+
+		/**
+		* This method present only the damaged rectangles of the back buffer, so the system copies less pixels to the screen.
+		* The whole frame must still be drawn, the content of the back buffer after the swap is undefined like after a full swap.
+		* An empty damage presents the whole frame, like zero rectangles with EGL_KHR_swap_buffers_with_damage.
+		* It uses EGL_KHR_swap_buffers_with_damage with EGL and GLX_MESA_copy_sub_buffer with GLX, and falls back to a full 
+		* swap when the driver doesn't support them (always with WGL).
 		* This method need to be implemented for each OS.
+		* @param damage The rectangles that changed since the last swap, from the top-left corner of the display.
 		*/
-		void swap_front_and_back() const;
+		void swap_front_and_back(const ndm::DamageRegion & damage);
 
-		void set_vertical_sync(const bool vertical_sync) const;
+		/**
+		* This method read back the pixels of the framebuffer of the context, the context must be current on the calling thread.
+		* The pixels are read from the buffer that is being drawn, so it must be called before swap_front_and_back(). The
+		* vector of the image is only resized when the size of the framebuffer changes, so an image can be reused each frame.
+		* This method need to be implemented for each OS.
+		* @param image The image that receives the pixels.
+		*/
+		void read_framebuffer(ndm::GLFramebufferImage & image) const;
+
+		/**
+		* This method set the number of vertical retraces to wait before a swap. An interval of 0 disables the synchronization,
+		* a negative interval enables the adaptive synchronization : the swap waits for |interval| retraces, but a late swap 
+		* happens immediately and tears instead of waiting for the next retrace. If the driver doesn't support the requested 
+		* interval, an exception is thrown.
+		* This method need to be implemented for each OS.
+		* @param interval The swap interval.
+		*/
+		void set_swap_interval(const std::int32_t interval);
+
+		/**
+		* This method enable or disable the synchronization of the swaps with the vertical retrace of the monitor.
+		* If the driver can't change the swap interval, an exception is thrown.
+		* @param vertical_sync If the vertical synchronization is enabled.
+		*/
+		inline void set_vertical_sync(const bool vertical_sync)
+		{
+			set_swap_interval(vertical_sync == true ? 1 : 0);
+		}
+
+		/**
+		* This method return the swap interval of the context.
+		* @return std::int32_t The swap interval
+		*/
+		inline std::int32_t get_swap_interval() const noexcept
+		{
+			return m_swap_interval;
+		}
+
+		/**
+		* This method return the swap interval modes supported by the driver, it is filled when the context is loaded.
+		* @return GLSwapControl The supported modes
+		*/
+		inline ndm::GLSwapControl get_swap_control() const noexcept
+		{
+			return m_swap_control;
+		}
+
+		/**
+		* This method return the timing statistics of the frames presented by this context, updated on each swap.
+		* @return GLFrameStatistics & The frame statistics
+		*/
+		inline const ndm::GLFrameStatistics & get_frame_statistics() const noexcept
+		{
+			return m_frame_timer.get_statistics();
+		}
+
+		/**
+		* This method clear the timing statistics of the frames presented by this context.
+		*/
+		inline void reset_frame_statistics() noexcept
+		{
+			m_frame_timer.reset();
+			m_render_scale.reset();
+		}
+
+		/**
+		* This method return the controller of the dynamic resolution, updated on each swap, to enable it and set its range
+		* or its target refresh rate. The target is not read from the monitor under the display, the caller sets it with
+		* Monitor::get_max_refresh_rate(), otherwise the refresh period measured by the context is used.
+		* @return GLRenderScaleController & The render scale controller
+		*/
+		inline ndm::GLRenderScaleController & get_render_scale_controller() noexcept
+		{
+			return m_render_scale;
+		}
+
+		/**
+		* This method return the scale of the resolution of the rendering for the next frame, 1 while the dynamic resolution 
+		* is disabled.
+		* @return double The render scale
+		*/
+		inline double get_render_scale() const noexcept
+		{
+			return m_render_scale.get_scale();
+		}
+
+		/**
+		* This method return the time available to render a frame, from the refresh rate and the swap interval.
+		* @return std::chrono::nanoseconds The frame budget
+		*/
+		inline std::chrono::nanoseconds get_frame_budget() const noexcept
+		{
+			return m_render_scale.get_frame_budget();
+		}
+
+		/**
+		* This method return the width to render the next frame at, the framebuffer width of the display at the render scale.
+		* A headless context has no display, so the width is 0.
+		* @return std::int64_t The render width
+		*/
+		inline std::int64_t get_render_width() const noexcept
+		{
+			return m_display_ptr != nullptr ? m_render_scale.get_render_size(m_display_ptr->get_framebuffer_width()) : 0;
+		}
+
+		/**
+		* This method return the height to render the next frame at, the framebuffer height of the display at the render scale.
+		* A headless context has no display, so the height is 0.
+		* @return std::int64_t The render height
+		*/
+		inline std::int64_t get_render_height() const noexcept
+		{
+			return m_display_ptr != nullptr ? m_render_scale.get_render_size(m_display_ptr->get_framebuffer_height()) : 0;
+		}
     };
 }
\ No newline at end of file
@@ -8,8 +8,11 @@
 
 namespace ndm
 {
+	class GLContext;
+
 	/**
 	* This structure describe the parameters to create of an OpenGL context for the current thread.
+	* If shared_context is not null, the new context shares its objects (textures, buffers, programs...) with it.
 	*/
 	struct GLContextParams
 	{
@@ -24,5 +27,6 @@ namespace ndm
 		bool debug_mode;
 		bool double_buffer;
 		bool samples_buffers;
+		const ndm::GLContext * shared_context;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+// STD includes
+#include <cstring>
+
+namespace ndm
+{
+	/**
+	* This function check if an extension is in a space separated extensions string, like the ones returned by WGL, GLX or EGL.
+	* @param extensions The extensions string, can be null.
+	* @param extension The name of the extension.
+	* @return bool If the extension is in the string.
+	*/
+	inline bool gl_has_extension(const char * extensions, const char * extension) noexcept
+	{
+		if (extensions == nullptr || extension == nullptr)
+			return false;
+
+		const std::size_t length = std::strlen(extension);
+		for (const char * current = std::strstr(extensions, extension); current != nullptr; current = std::strstr(current + length, extension))
+		{
+			if ((current == extensions || current[-1] == ' ') && (current[length] == ' ' || current[length] == '\0'))
+				return true;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <array>
+#include <chrono>
+
+namespace ndm
+{
+	/**
+	* This structure describe the timing of the frames presented by an OpenGL context, it is updated on each swap and 
+	* can be read each frame without allocation.
+	* - swap_cpu_duration : the time spent by the CPU in the last swap call
+	* - last_frame_time : the interval between the last two presents
+	* - refresh_period : the refresh period of the display used to count the missed intervals
+	* - frame_time_p50, frame_time_p95, frame_time_p99 : the rolling percentiles of the recent frame times
+	* - present_interval_histogram : the number of presents per interval, each bin is one millisecond wide and the last bin counts all the longer intervals
+	* - missed_intervals : the number of refresh intervals missed since the creation of the context
+	* - frame_count : the number of presents since the creation of the context
+	* - hardware_timestamps : true if the timings come from the driver (OML sync control) instead of the CPU clock
+	*/
+	struct GLFrameStatistics
+	{
+		static constexpr std::size_t histogram_bins = 64;
+
+		std::chrono::nanoseconds swap_cpu_duration;
+		std::chrono::nanoseconds last_frame_time;
+		std::chrono::nanoseconds refresh_period;
+		std::chrono::nanoseconds frame_time_p50;
+		std::chrono::nanoseconds frame_time_p95;
+		std::chrono::nanoseconds frame_time_p99;
+		std::array<std::uint32_t, histogram_bins> present_interval_histogram;
+		std::uint64_t missed_intervals;
+		std::uint64_t frame_count;
+		bool hardware_timestamps;
+	};
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <chrono>
+#include <algorithm>
+
+// NDM includes
+#include <ndm/opengl/gl_frame_statistics.hpp>
+
+namespace ndm
+{
+	/**
+	* This class record the timing of each swap of an OpenGL context and keep the frame statistics up to date.
+	* It only uses fixed-size arrays, so recording a frame never allocates memory.
+	*/
+	class GLFrameTimer
+	{
+	public:
+
+		// Number of recent frames used for the rolling percentiles
+		static constexpr std::size_t window_size = 128;
+
+	private:
+
+		// Attributes
+		ndm::GLFrameStatistics m_statistics;
+		std::array<std::chrono::nanoseconds, window_size> m_frame_times;
+		std::array<std::chrono::nanoseconds, window_size> m_sorted_frame_times;
+		std::size_t m_frame_times_count;
+		std::size_t m_frame_times_index;
+		std::chrono::steady_clock::time_point m_last_present;
+		std::int64_t m_last_msc;
+		std::int32_t m_swap_interval;
+
+		// Update the statistics with the interval between two presents
+		inline void record_interval(const std::chrono::nanoseconds interval, const std::int64_t elapsed_intervals) noexcept
+		{
+			m_statistics.last_frame_time = interval;
+			m_statistics.frame_count++;
+
+			// Count the refresh intervals elapsed after the expected one
+			const std::int64_t expected_intervals = std::max<std::int64_t>(1, std::abs(m_swap_interval));
+			if (elapsed_intervals > expected_intervals)
+				m_statistics.missed_intervals += static_cast<std::uint64_t>(elapsed_intervals - expected_intervals);
+
+			// Histogram of the present intervals
+			const std::int64_t bin = std::chrono::duration_cast<std::chrono::milliseconds>(interval).count();
+			m_statistics.present_interval_histogram[static_cast<std::size_t>(std::clamp<std::int64_t>(bin, 0, ndm::GLFrameStatistics::histogram_bins - 1))]++;
+
+			// Rolling percentiles of the recent frame times
+			m_frame_times[m_frame_times_index] = interval;
+			m_frame_times_index = (m_frame_times_index + 1) % window_size;
+			m_frame_times_count = std::min(m_frame_times_count + 1, window_size);
+
+			const auto first = m_sorted_frame_times.begin();
+			const auto last = first + static_cast<std::ptrdiff_t>(m_frame_times_count);
+			std::copy(m_frame_times.begin(), m_frame_times.begin() + static_cast<std::ptrdiff_t>(m_frame_times_count), first);
+			m_statistics.frame_time_p99 = percentile(first, last, 99);
+			m_statistics.frame_time_p95 = percentile(first, last, 95);
+			m_statistics.frame_time_p50 = percentile(first, last, 50);
+		}
+
+		// Estimate the number of refresh intervals elapsed from the refresh period
+		inline std::int64_t estimate_intervals(const std::chrono::nanoseconds interval) const noexcept
+		{
+			const std::int64_t period = m_statistics.refresh_period.count();
+			return period > 0 ? (interval.count() + period / 2) / period : 0;
+		}
+
+		// Partially sort the range to find the requested percentile
+		template<typename Iterator>
+		static inline std::chrono::nanoseconds percentile(Iterator first, Iterator last, const std::ptrdiff_t percent) noexcept
+		{
+			const std::ptrdiff_t count = last - first;
+			Iterator nth = first + std::min<std::ptrdiff_t>(count - 1, (count * percent) / 100);
+			std::nth_element(first, nth, last);
+			return *nth;
+		}
+
+	public:
+
+		/**
+		* Constructor of this class.
+		*/
+		inline GLFrameTimer() noexcept :
+			m_statistics(),
+			m_swap_interval(1)
+		{
+			reset();
+		}
+
+		/**
+		* This method clear all the statistics, the refresh period and the swap interval are kept.
+		*/
+		inline void reset() noexcept
+		{
+			const std::chrono::nanoseconds refresh_period = m_statistics.refresh_period;
+			m_statistics = {};
+			m_statistics.refresh_period = refresh_period;
+			m_frame_times = {};
+			m_sorted_frame_times = {};
+			m_frame_times_count = 0;
+			m_frame_times_index = 0;
+			m_last_present = std::chrono::steady_clock::time_point();
+			m_last_msc = -1;
+		}
+
+		/**
+		* This method set the refresh period of the display, a null period disables the count of missed intervals.
+		* @param refresh_period The refresh period.
+		*/
+		inline void set_refresh_period(const std::chrono::nanoseconds refresh_period) noexcept
+		{
+			m_statistics.refresh_period = refresh_period;
+		}
+
+		/**
+		* This method set the swap interval of the context, it is the number of refresh intervals expected between two presents.
+		* @param swap_interval The swap interval.
+		*/
+		inline void set_swap_interval(const std::int32_t swap_interval) noexcept
+		{
+			m_swap_interval = swap_interval;
+		}
+
+		/**
+		* This method record a swap timed with the CPU clock only, the missed intervals are estimated from the refresh period.
+		* The media stream counter of the previous present is forgotten, the next swap with a counter estimates its intervals too.
+		* @param swap_begin The time before the swap call.
+		* @param swap_end The time after the swap call.
+		*/
+		inline void record(const std::chrono::steady_clock::time_point swap_begin, const std::chrono::steady_clock::time_point swap_end) noexcept
+		{
+			m_statistics.swap_cpu_duration = swap_end - swap_begin;
+			m_statistics.hardware_timestamps = false;
+
+			if (m_last_present != std::chrono::steady_clock::time_point())
+				record_interval(swap_end - m_last_present, estimate_intervals(swap_end - m_last_present));
+
+			m_last_present = swap_end;
+			m_last_msc = -1;
+		}
+
+		/**
+		* This method record a swap with the media stream counter of the driver (OML sync control), the missed intervals 
+		* are counted from the vertical retraces that really happened between two presents.
+		* @param swap_begin The time before the swap call.
+		* @param swap_end The time after the swap call.
+		* @param msc The media stream counter, incremented on each vertical retrace.
+		*/
+		inline void record(const std::chrono::steady_clock::time_point swap_begin, const std::chrono::steady_clock::time_point swap_end, const std::int64_t msc) noexcept
+		{
+			m_statistics.swap_cpu_duration = swap_end - swap_begin;
+			m_statistics.hardware_timestamps = true;
+
+			if (m_last_present != std::chrono::steady_clock::time_point())
+				record_interval(swap_end - m_last_present, m_last_msc >= 0 ? msc - m_last_msc : estimate_intervals(swap_end - m_last_present));
+
+			m_last_present = swap_end;
+			m_last_msc = msc;
+		}
+
+		/**
+		* This method return the statistics of the recorded frames.
+		* @return GLFrameStatistics & The frame statistics
+		*/
+		inline const ndm::GLFrameStatistics & get_statistics() const noexcept
+		{
+			return m_statistics;
+		}
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <vector>
+
+namespace ndm
+{
+	/**
+	* This structure contains the pixels read back from the framebuffer of an OpenGL context.
+	* The pixels are RGBA with 8 bits per component, the rows are stored from the bottom to the top like OpenGL.
+	*/
+	struct GLFramebufferImage
+	{
+		std::uint64_t width;
+		std::uint64_t height;
+		std::vector<std::uint8_t> pixels;
+	};
+}
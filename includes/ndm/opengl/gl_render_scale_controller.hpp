@@ -0,0 +1,238 @@
+#pragma once
+
+// STD includes
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <chrono>
+#include <algorithm>
+
+// NDM includes
+#include <ndm/opengl/gl_frame_statistics.hpp>
+
+namespace ndm
+{
+	/**
+	* This class choose the scale of the resolution of the rendering from the recent frame times, for the dynamic resolution :
+	* a GPU-bound application renders into a framebuffer of get_render_size() and scales it up to the display when it is
+	* presented. The scale goes down as soon as the frames exceed the frame budget and goes up slowly, with a hysteresis
+	* between both thresholds so the scale doesn't oscillate. With the vertical synchronization, the frames never take less
+	* than the budget, so a higher scale is tried after a stable period, and the period doubles each time the try fails.
+	* It only uses fixed-size arrays, so updating the scale never allocates memory.
+	*/
+	class GLRenderScaleController
+	{
+	public:
+
+		// Number of frames since the last change used to evaluate the frame time
+		static constexpr std::size_t window_size = 16;
+
+		// The scale goes down when the 90th percentile of the frame times is over this fraction of the budget
+		static constexpr double downscale_threshold = 1.15;
+
+		// The scale goes up when the 90th percentile of the frame times is under this fraction of the budget
+		static constexpr double upscale_threshold = 0.8;
+
+		// Step of the scale when it goes up, the scale goes down in proportion of the excess of time
+		static constexpr double upscale_step = 0.05;
+
+		// Number of frames at the budget before a higher scale is tried, doubled by each failed try
+		static constexpr std::uint64_t min_probe_delay = 120;
+		static constexpr std::uint64_t max_probe_delay = 1920;
+
+		// Budget used when the refresh rate of the display is unknown
+		static constexpr std::chrono::nanoseconds default_frame_budget = std::chrono::nanoseconds(1000000000 / 60);
+
+	private:
+
+		// Attributes
+		std::array<std::chrono::nanoseconds, window_size> m_frame_times;
+		std::array<std::chrono::nanoseconds, window_size> m_sorted_frame_times;
+		std::size_t m_frame_times_count;
+		std::size_t m_frame_times_index;
+		std::uint64_t m_last_frame_count;
+		std::uint64_t m_frames_since_change;
+		std::uint64_t m_probe_delay;
+		std::chrono::nanoseconds m_target_frame_budget;
+		std::chrono::nanoseconds m_frame_budget;
+		double m_min_scale;
+		double m_max_scale;
+		double m_scale;
+		bool m_probing;
+		bool m_enabled;
+
+		// Forget the frame times rendered with the previous scale
+		inline void change_scale(const double scale) noexcept
+		{
+			m_scale = std::clamp(scale, m_min_scale, m_max_scale);
+			m_frame_times_count = 0;
+			m_frame_times_index = 0;
+			m_frames_since_change = 0;
+		}
+
+	public:
+
+		/**
+		* Constructor of this class.
+		*/
+		inline GLRenderScaleController() noexcept :
+			m_target_frame_budget(0),
+			m_frame_budget(default_frame_budget),
+			m_min_scale(0.5),
+			m_max_scale(1.0),
+			m_enabled(false)
+		{
+			reset();
+		}
+
+		/**
+		* This method clear the recent frame times and set the scale to the maximum scale, the settings are kept.
+		*/
+		inline void reset() noexcept
+		{
+			m_frame_times = {};
+			m_sorted_frame_times = {};
+			m_last_frame_count = 0;
+			m_probe_delay = min_probe_delay;
+			m_probing = false;
+			change_scale(m_max_scale);
+		}
+
+		/**
+		* This method enable or disable the dynamic resolution, the scale stays at the maximum scale while it is disabled.
+		* @param enabled If the scale follows the frame times.
+		*/
+		inline void set_enabled(const bool enabled) noexcept
+		{
+			m_enabled = enabled;
+			reset();
+		}
+
+		/**
+		* This method return true if the dynamic resolution is enabled.
+		* @return bool If the scale follows the frame times
+		*/
+		inline bool is_enabled() const noexcept
+		{
+			return m_enabled;
+		}
+
+		/**
+		* This method set the range of the scale, the scale is clamped in the range. The maximum can be over 1 to supersample.
+		* @param min_scale The minimum scale, greater than zero.
+		* @param max_scale The maximum scale, not less than the minimum scale.
+		*/
+		inline void set_scale_range(const double min_scale, const double max_scale) noexcept
+		{
+			m_min_scale = std::max(0.01, min_scale);
+			m_max_scale = std::max(m_min_scale, max_scale);
+			change_scale(m_scale);
+		}
+
+		/**
+		* This method set the refresh rate the frames must keep up with. A null rate uses the refresh period measured by the
+		* context (or 60 Hz when it is unknown) with its swap interval. The context doesn't know the monitors, the caller 
+		* gives Monitor::get_max_refresh_rate() of the monitor under the display when the context is loaded, and again when 
+		* the display moves to another monitor (MOVED, MONITORS_CHANGED).
+		* @param refresh_rate The target refresh rate in Hz.
+		*/
+		inline void set_target_refresh_rate(const unsigned long refresh_rate) noexcept
+		{
+			m_target_frame_budget = std::chrono::nanoseconds(refresh_rate > 0 ? 1000000000ll / static_cast<long long>(refresh_rate) : 0);
+			if (m_target_frame_budget.count() > 0)
+				m_frame_budget = m_target_frame_budget;
+		}
+
+		/**
+		* This method update the scale with the last frame recorded in the statistics, it is called after each swap that
+		* waits for the vertical retrace like the frames it measures (not after a GLX_MESA_copy_sub_buffer present).
+		* @param statistics The frame statistics of the context.
+		* @param swap_interval The swap interval of the context.
+		*/
+		inline void update(const ndm::GLFrameStatistics & statistics, const std::int32_t swap_interval) noexcept
+		{
+			// The budget follows the refresh period and the swap interval, unless a target refresh rate is set
+			if (m_target_frame_budget.count() > 0)
+				m_frame_budget = m_target_frame_budget;
+			else if (statistics.refresh_period.count() > 0)
+				m_frame_budget = statistics.refresh_period * std::max<std::int32_t>(1, std::abs(swap_interval));
+			else
+				m_frame_budget = default_frame_budget;
+
+			// Only the new frames are counted, the first present has no frame time
+			if (statistics.frame_count == m_last_frame_count)
+				return;
+			m_last_frame_count = statistics.frame_count;
+			if (m_enabled == false)
+				return;
+
+			m_frame_times[m_frame_times_index] = statistics.last_frame_time;
+			m_frame_times_index = (m_frame_times_index + 1) % window_size;
+			m_frame_times_count = std::min(m_frame_times_count + 1, window_size);
+			m_frames_since_change++;
+			if (m_frame_times_count < window_size)
+				return;
+
+			// The 90th percentile ignores a single hitch, like a resource upload, but not a sustained load
+			std::copy(m_frame_times.begin(), m_frame_times.end(), m_sorted_frame_times.begin());
+			const auto nth = m_sorted_frame_times.begin() + static_cast<std::ptrdiff_t>((window_size * 9) / 10);
+			std::nth_element(m_sorted_frame_times.begin(), nth, m_sorted_frame_times.end());
+			const double frame_time = static_cast<double>(nth->count());
+			const double budget = static_cast<double>(m_frame_budget.count());
+
+			if (frame_time > budget * downscale_threshold && m_scale > m_min_scale)
+			{
+				if (m_probing == true)
+				{
+					// A higher scale that fails during its try goes back to the previous scale and is tried again later
+					m_probe_delay = std::min(m_probe_delay * 2, max_probe_delay);
+					change_scale(m_scale - upscale_step);
+				} else {
+					// The time of a GPU-bound frame follows the number of pixels, the square of the scale
+					m_probe_delay = min_probe_delay;
+					change_scale(std::min(m_scale - upscale_step, m_scale * std::sqrt(budget / frame_time) * 0.95));
+				}
+				m_probing = false;
+			} else if (frame_time < budget * upscale_threshold && m_scale < m_max_scale) {
+				m_probing = false;
+				change_scale(m_scale + upscale_step);
+			} else if (m_probing == true) {
+				// The higher scale keeps the budget, the next try waits less
+				m_probe_delay = std::max(m_probe_delay / 2, min_probe_delay);
+				m_probing = false;
+			} else if (frame_time <= budget * downscale_threshold && m_scale < m_max_scale && m_frames_since_change >= m_probe_delay) {
+				m_probing = true;
+				change_scale(m_scale + upscale_step);
+			}
+		}
+
+		/**
+		* This method return the scale of the resolution of the rendering for the next frame.
+		* @return double The render scale
+		*/
+		inline double get_scale() const noexcept
+		{
+			return m_scale;
+		}
+
+		/**
+		* This method return the time available to render a frame, from the last update.
+		* @return std::chrono::nanoseconds The frame budget
+		*/
+		inline std::chrono::nanoseconds get_frame_budget() const noexcept
+		{
+			return m_frame_budget;
+		}
+
+		/**
+		* This method return a size of the framebuffer at the render scale, never less than one pixel.
+		* @param size The width or the height of the framebuffer of the display.
+		* @return std::int64_t The size to render
+		*/
+		inline std::int64_t get_render_size(const std::int64_t size) const noexcept
+		{
+			return size > 0 ? std::max<std::int64_t>(1, std::llround(static_cast<double>(size) * m_scale)) : 0;
+		}
+	};
+}
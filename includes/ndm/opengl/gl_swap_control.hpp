@@ -0,0 +1,17 @@
+#pragma once
+
+namespace ndm
+{
+	/**
+	* This structure describe the swap interval modes supported by the driver for an OpenGL context.
+	* - swap_interval : the swap interval can be changed (WGL_EXT_swap_control, GLX_EXT_swap_control, GLX_MESA_swap_control or GLX_SGI_swap_control)
+	* - immediate : an interval of 0 is supported, the swaps are not synchronized with the vertical retrace
+	* - adaptive : negative intervals are supported, a late swap tears instead of waiting for the next retrace (WGL_EXT_swap_control_tear, GLX_EXT_swap_control_tear)
+	*/
+	struct GLSwapControl
+	{
+		bool swap_interval;
+		bool immediate;
+		bool adaptive;
+	};
+}
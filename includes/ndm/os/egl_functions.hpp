@@ -0,0 +1,22 @@
+#pragma once
+
+// Linux headless only
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// EGL includes
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace ndm
+{
+    // EGL function pointers, shared by the whole process
+    inline PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = nullptr;
+    inline PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC eglSwapBuffersWithDamageKHR = nullptr;
+
+    // The surfaceless display is shared by the displays and the contexts of the process, it is initialized by the first 
+    // acquisition and terminated by the last release, EGL doesn't count the initializations of a display itself
+    EGLDisplay egl_acquire_display();
+    void egl_release_display();
+}
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+// Linux only, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// X11 NDM includes
+#include <ndm/os/x11_functions.hpp>
+
+// GLX includes
+#include <GL/glx.h>
+#include <GL/glxext.h>
+
+namespace ndm
+{
+    // GLX function pointers, shared by the whole process
+    inline PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB = nullptr;
+    inline PFNGLXSWAPINTERVALEXTPROC glXSwapIntervalEXT = nullptr;
+    inline PFNGLXSWAPINTERVALMESAPROC glXSwapIntervalMESA = nullptr;
+    inline PFNGLXSWAPINTERVALSGIPROC glXSwapIntervalSGI = nullptr;
+    inline PFNGLXGETSYNCVALUESOMLPROC glXGetSyncValuesOML = nullptr;
+    inline PFNGLXGETMSCRATEOMLPROC glXGetMscRateOML = nullptr;
+    inline PFNGLXCOPYSUBBUFFERMESAPROC glXCopySubBufferMESA = nullptr;
+}
+
+#endif
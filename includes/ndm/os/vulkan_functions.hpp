@@ -0,0 +1,54 @@
+#pragma once
+
+// Vulkan is optional, the surfaces are only compiled with NDM_ENABLE_VULKAN and the application links the Vulkan loader
+#if defined(NDM_ENABLE_VULKAN)
+
+// STD includes
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// The window system extension of each OS, defined before the Vulkan header to declare its functions
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef VK_USE_PLATFORM_WIN32_KHR
+        #define VK_USE_PLATFORM_WIN32_KHR
+    #endif
+#elif defined(__linux__) && !defined(NDM_HEADLESS)
+    #ifndef VK_USE_PLATFORM_XLIB_KHR
+        #define VK_USE_PLATFORM_XLIB_KHR
+    #endif
+#endif
+
+// Vulkan includes
+#include <vulkan/vulkan.h>
+
+namespace ndm
+{
+    // Present mode with the lowest latency among the supported modes : MAILBOX never waits and never tears, FIFO_RELAXED
+    // only tears when a frame is late, FIFO is always supported
+    inline VkPresentModeKHR vulkan_choose_present_mode(const std::vector<VkPresentModeKHR> & supported_modes) noexcept
+    {
+        for (const VkPresentModeKHR mode : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR })
+            if (std::find(supported_modes.begin(), supported_modes.end(), mode) != supported_modes.end())
+                return mode;
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    // Present mode with the lowest latency supported by a surface on a physical device
+    inline VkPresentModeKHR vulkan_choose_present_mode(VkPhysicalDevice physical_device, VkSurfaceKHR surface)
+    {
+        std::uint32_t count = 0;
+        if (vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &count, nullptr) != VK_SUCCESS)
+            return VK_PRESENT_MODE_FIFO_KHR;
+
+        std::vector<VkPresentModeKHR> supported_modes(count);
+        if (vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &count, supported_modes.data()) < VK_SUCCESS)
+            return VK_PRESENT_MODE_FIFO_KHR;
+        supported_modes.resize(count);
+
+        return vulkan_choose_present_mode(supported_modes);
+    }
+}
+
+#endif
@@ -19,11 +19,25 @@ namespace ndm
     typedef HGLRC(WINAPI* PFNWGLCREATECONTEXTATTRIBSARBPROC) (HDC hDC, HGLRC hShareContext, const int* attribList);
     typedef BOOL(WINAPI* PFNWGLCHOOSEPIXELFORMATARBPROC) (HDC hdc, const int* piAttribIList, const FLOAT* pfAttribFList, UINT nMaxFormats, int* piFormats, UINT* nNumFormats);
     typedef BOOL(WINAPI* PFNWGLSWAPINTERVALEXTPROC) (int interval);
+    typedef const char * (WINAPI* PFNWGLGETEXTENSIONSSTRINGARBPROC) (HDC hdc);
 
-    // WGL function pointers
-    inline static PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
-    inline static PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
-    inline static PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT = nullptr;
+    // WGL function pointers, shared by the whole process
+    inline PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
+    inline PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
+    inline PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT = nullptr;
+    inline PFNWGLGETEXTENSIONSSTRINGARBPROC wglGetExtensionsStringARB = nullptr;
+
+    // Per-monitor DPI function typedefs, loaded from user32 because they are missing before Windows 10
+    typedef BOOL(WINAPI* PFNSETPROCESSDPIAWARENESSCONTEXTPROC) (HANDLE value);
+    typedef UINT(WINAPI* PFNGETDPIFORWINDOWPROC) (HWND hwnd);
+
+    // Per-monitor DPI function pointers, shared by the whole process
+    inline PFNSETPROCESSDPIAWARENESSCONTEXTPROC win32SetProcessDpiAwarenessContext = nullptr;
+    inline PFNGETDPIFORWINDOWPROC win32GetDpiForWindow = nullptr;
+
+    // Per-monitor DPI constants, DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 is a pseudo handle
+    inline const HANDLE WIN32_DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 = reinterpret_cast<HANDLE>(static_cast<LONG_PTR>(-4));
+    constexpr UINT WIN32_WM_DPICHANGED = 0x02E0;
 
     // WGL constants
     constexpr int WGL_DRAW_TO_WINDOW_ARB = 0x2001;
@@ -0,0 +1,38 @@
+#pragma once
+
+// Linux only, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// STD includes
+#include <cstdint>
+
+// X11 includes
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/Xatom.h>
+#include <X11/extensions/sync.h>
+
+namespace ndm
+{
+    class Display;
+
+    // X11 events process functions
+    void x11_process_events(ndm::Display * display, const XEvent & event);
+
+    // Area of a monitor in the root window and the DPI derived from its physical size
+    struct X11MonitorDpi
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+        std::uint32_t dpi;
+    };
+
+    // EWMH constants
+    constexpr long NET_WM_STATE_REMOVE = 0;
+    constexpr long NET_WM_STATE_ADD = 1;
+    constexpr long NET_WM_STATE_TOGGLE = 2;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+// Linux only, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// STD includes
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+// X11 includes
+#include <X11/extensions/Xrandr.h>
+
+namespace ndm
+{
+    // Refresh rate of a mode in Hz from its pixel clock and its total size (blanking included)
+    inline std::uint32_t x11_get_refresh_rate(const XRRModeInfo & mode) noexcept
+    {
+        double vertical_total = static_cast<double>(mode.vTotal);
+        if ((mode.modeFlags & RR_DoubleScan) != 0)
+            vertical_total *= 2.0;
+        if ((mode.modeFlags & RR_Interlace) != 0)
+            vertical_total /= 2.0;
+
+        if (mode.hTotal == 0 || vertical_total == 0.0)
+            return 0;
+
+        return static_cast<std::uint32_t>(std::lround(static_cast<double>(mode.dotClock) / (static_cast<double>(mode.hTotal) * vertical_total)));
+    }
+
+    // DPI of a monitor from its physical size, rounded to a scale multiple of 0.25 and never below a scale of 1. The size 
+    // is missing on some outputs and made up on projectors and virtual outputs (like 160x90 mm), these get the default DPI
+    inline std::uint32_t x11_get_monitor_dpi(const XRRMonitorInfo & monitor, const std::uint32_t default_dpi) noexcept
+    {
+        if (monitor.mwidth <= 0 || monitor.mheight <= 0 || monitor.width <= 0)
+            return default_dpi;
+
+        const double dpi = static_cast<double>(monitor.width) * 25.4 / static_cast<double>(monitor.mwidth);
+        if (dpi < 48.0 || dpi > 480.0)
+            return default_dpi;
+
+        const double scale = std::max(1.0, std::round(dpi / static_cast<double>(default_dpi) * 4.0) / 4.0);
+        return static_cast<std::uint32_t>(std::lround(scale * static_cast<double>(default_dpi)));
+    }
+}
+
+#endif
@@ -0,0 +1,237 @@
+#pragma once
+
+// STD includes
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/display/damage_region.hpp>
+
+// X11 includes
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+#include <X11/extensions/XShm.h>
+#endif
+
+namespace ndm
+{
+	/**
+	* This class is a surface of a display where the pixels are written by the CPU, for the views that are not rendered with
+	* OpenGL (video preview, software rasterizer...). The pixels are 32 bits 0xAARRGGBB values (the alpha is ignored), the rows
+	* are stored from the top to the bottom and two rows are separated by get_stride() bytes.
+	* The framebuffer is double buffered : the pixels of the back buffer are written while the front buffer is presented,
+	* present() flips the buffers. The memory of the buffers is read directly by the system when it is possible (MIT-SHM on
+	* X11, DIB section on Win32), so there is no copy between the buffers and the server.
+	*/
+	class SoftwareFramebuffer
+	{
+	public:
+
+		// Number of buffers in the swap chain
+		static constexpr std::size_t buffer_count = 2;
+
+	private:
+
+		// Attributes
+		ndm::Display * m_display_ptr;
+		bool m_loaded;
+		std::uint64_t m_width;
+		std::uint64_t m_height;
+		std::uint64_t m_stride;
+		std::size_t m_back_buffer;
+		std::array<std::uint32_t *, buffer_count> m_pixels;
+
+		#if defined(_WIN32) || defined(_WIN64)
+		// Win32 native framebuffer attributes, each buffer is a DIB section selected in a memory device context
+		std::array<HDC, buffer_count> m_memory_device_contexts;
+		std::array<HBITMAP, buffer_count> m_bitmaps;
+		std::array<HGDIOBJ, buffer_count> m_previous_bitmaps;
+		#endif
+
+		#if defined(__linux__) && !defined(NDM_HEADLESS)
+		// X11 native framebuffer attributes, each buffer is an image in a shared memory segment when MIT-SHM is available
+		std::array<XImage *, buffer_count> m_images;
+		std::array<XShmSegmentInfo, buffer_count> m_shm_segments;
+		std::array<std::uint64_t, buffer_count> m_shm_tickets;
+		GC m_gc;
+		bool m_shm;
+
+		/**
+		* This method wait until the server has read all the images sent before the given ticket.
+		* @param ticket The ticket of the last image that must be read
+		*/
+		void wait_shm_completion(const std::uint64_t ticket);
+		#endif
+
+		#if defined(__linux__) && defined(NDM_HEADLESS)
+		// Headless framebuffer attributes, the buffers are never presented
+		std::array<std::vector<std::uint32_t>, buffer_count> m_buffers;
+		#endif
+
+		/**
+		* This method create the buffers with the given size.
+		* This method need to be implemented for each OS.
+		*/
+		void create_buffers(const std::uint64_t width, const std::uint64_t height);
+
+		/**
+		* This method destroy the buffers.
+		* This method need to be implemented for each OS.
+		*/
+		void destroy_buffers();
+
+		/**
+		* This method copy the damaged rectangles of a buffer to another one, so the back buffer receives the last presented frame.
+		* @param source The index of the buffer to read
+		* @param destination The index of the buffer to write
+		* @param damage The rectangles to copy, clipped to the size of the buffers
+		*/
+		inline void copy_damage(const std::size_t source, const std::size_t destination, const ndm::DamageRegion & damage) noexcept
+		{
+			const std::uint8_t * source_pixels = reinterpret_cast<const std::uint8_t *>(m_pixels[source]);
+			std::uint8_t * destination_pixels = reinterpret_cast<std::uint8_t *>(m_pixels[destination]);
+
+			for (const ndm::DisplayRect & rect : damage)
+			{
+				const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, static_cast<std::int64_t>(m_width), static_cast<std::int64_t>(m_height));
+				if (clipped.width <= 0 || clipped.height <= 0)
+					continue;
+
+				const std::size_t offset = static_cast<std::size_t>(clipped.y) * m_stride + static_cast<std::size_t>(clipped.x) * sizeof(std::uint32_t);
+				const std::size_t row_size = static_cast<std::size_t>(clipped.width) * sizeof(std::uint32_t);
+				for (std::int64_t y = 0; y < clipped.height; y++)
+					std::memcpy(destination_pixels + offset + y * m_stride, source_pixels + offset + y * m_stride, row_size);
+			}
+		}
+
+	public:
+
+		// Constructor
+		inline SoftwareFramebuffer(ndm::Display * display_ptr) :
+			m_display_ptr(display_ptr),
+			m_loaded(false),
+			m_width(0),
+			m_height(0),
+			m_stride(0),
+			m_back_buffer(0),
+			m_pixels()
+		{
+			if(m_display_ptr == nullptr)
+				throw std::runtime_error("Can't instantiate a SoftwareFramebuffer with a null display !");
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline SoftwareFramebuffer(SoftwareFramebuffer &) = delete;
+		inline SoftwareFramebuffer(const SoftwareFramebuffer &) = delete;
+
+		// Destructor
+		inline virtual ~SoftwareFramebuffer() = default;
+
+		/**
+		* This method load the framebuffer with the client size of the display.
+		* If the buffers cannot be created, an exception is thrown.
+		* This method need to be implemented for each OS.
+		*/
+		void load();
+
+		/**
+		* This method unload the framebuffer by releasing the buffers.
+		* This method need to be implemented for each OS.
+		*/
+		void unload();
+
+		/**
+		* This method recreate the buffers with a new size, usually when the display is resized. The content of the buffers is lost.
+		* If the new buffers can't be created, the framebuffer is unloaded before the exception is thrown again.
+		* @param width The new width in pixels.
+		* @param height The new height in pixels.
+		*/
+		inline void resize(const std::uint64_t width, const std::uint64_t height)
+		{
+			if(m_loaded == false)
+				throw std::runtime_error("The software framebuffer is not loaded !");
+
+			destroy_buffers();
+			try {
+				create_buffers(width, height);
+			} catch (...) {
+				unload();
+				throw;
+			}
+		}
+
+		/**
+		* This method present the back buffer on the display and flip the buffers. If the new back buffer is still read by the
+		* system, the method waits until it can be written.
+		* This method need to be implemented for each OS.
+		*/
+		void present();
+
+		/**
+		* This method present only the damaged rectangles of the back buffer and flip the buffers. The pixels outside of the 
+		* damage are not sent to the system, so only the rectangles that changed since the last present must be given. The
+		* damaged rectangles are then copied to the new back buffer, so it always contains the last presented frame and only 
+		* the next damage has to be drawn. After a full present(), the content of the back buffer is two frames old. An empty 
+		* damage, or a damage outside of the buffers, presents the whole back buffer like present().
+		* This method need to be implemented for each OS.
+		* @param damage The rectangles that changed since the last present.
+		*/
+		void present(const ndm::DamageRegion & damage);
+
+		/**
+		* This method return the pixels of the back buffer, the pointer changes after each call to present().
+		* @return std::uint32_t * The first pixel of the top row
+		*/
+		inline std::uint32_t * get_pixels() noexcept
+		{
+			return m_pixels[m_back_buffer];
+		}
+
+		/**
+		* This method return the width of the buffers in pixels.
+		* @return std::uint64_t The width
+		*/
+		inline std::uint64_t get_width() const noexcept
+		{
+			return m_width;
+		}
+
+		/**
+		* This method return the height of the buffers in pixels.
+		* @return std::uint64_t The height
+		*/
+		inline std::uint64_t get_height() const noexcept
+		{
+			return m_height;
+		}
+
+		/**
+		* This method return the number of bytes between two rows of the buffers.
+		* @return std::uint64_t The stride
+		*/
+		inline std::uint64_t get_stride() const noexcept
+		{
+			return m_stride;
+		}
+
+		/**
+		* This method return true if the buffers are read by the system without copy (MIT-SHM on X11, always on Win32).
+		* @return bool If the presentation is zero copy
+		*/
+		bool is_zero_copy() const noexcept;
+
+		/**
+		* This method return true if the framebuffer is loaded.
+		* @return bool If the framebuffer is loaded or not
+		*/
+		inline bool is_loaded() const noexcept
+		{
+			return m_loaded;
+		}
+	};
+}
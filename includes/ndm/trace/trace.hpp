@@ -0,0 +1,301 @@
+#pragma once
+
+// The tracing is compiled only with NDM_ENABLE_TRACE, otherwise the macros are empty and the scopes cost nothing
+#if defined(NDM_ENABLE_TRACE)
+
+// STD includes
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <vector>
+
+namespace ndm
+{
+	/**
+	* This struct is a scope recorded by a thread, the fields are atomics so the export can read them while the thread writes.
+	*/
+	struct TraceRecord
+	{
+		std::atomic<const char *> name = nullptr;
+		std::atomic<std::int64_t> start = 0;
+		std::atomic<std::int64_t> duration = 0;
+	};
+
+	/**
+	* This class is the ring of the scopes recorded by a thread. Only its thread writes it, the oldest scopes are
+	* overwritten when the ring is full. When the thread ends, the buffer is given to the next new thread.
+	*/
+	class TraceBuffer
+	{
+	public:
+
+		// The capacity must be a power of two
+		static constexpr std::size_t capacity = 4096;
+		static_assert((capacity & (capacity - 1)) == 0, "The capacity of the trace ring must be a power of two !");
+
+	private:
+
+		// Attributes
+		std::array<ndm::TraceRecord, capacity> m_records;
+		std::atomic<std::uint64_t> m_head = 0;
+		std::atomic<std::uint64_t> m_first = 0;
+		std::atomic<const char *> m_thread_name = nullptr;
+		std::atomic<std::uint32_t> m_thread_id = 0;
+		std::atomic<bool> m_used = true;
+		ndm::TraceBuffer * m_next = nullptr;
+
+		friend class Trace;
+
+	public:
+
+		/**
+		* This method record a scope, it must only be called by the thread of the buffer.
+		* @param name The name of the scope, a string that lives until the export
+		* @param start The start of the scope in nanoseconds
+		* @param duration The duration of the scope in nanoseconds
+		*/
+		inline void push(const char * name, const std::int64_t start, const std::int64_t duration) noexcept
+		{
+			const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+			ndm::TraceRecord & record = m_records[head & (capacity - 1)];
+			record.name.store(name, std::memory_order_relaxed);
+			record.start.store(start, std::memory_order_relaxed);
+			record.duration.store(duration, std::memory_order_relaxed);
+			m_head.store(head + 1, std::memory_order_release);
+		}
+	};
+
+	/**
+	* This class gives the buffer of each thread and exports the scopes of all the threads in the Chrome trace event format
+	* (chrome://tracing, Perfetto). The buffer of a thread that has ended is reused by the next new thread, so there are
+	* never more buffers than threads running at the same time, and the scopes of an ended thread can be exported until 
+	* then.
+	*/
+	class Trace
+	{
+	private:
+
+		// The buffers of all the threads, a buffer is pushed at the head of the list when no ended thread left one
+		static inline std::atomic<ndm::TraceBuffer *> s_buffers = nullptr;
+		static inline std::atomic<std::uint32_t> s_thread_count = 0;
+
+		// Give the buffer of the calling thread, a buffer released by an ended thread or a new one. It returns null when 
+		// the memory is exhausted, the scopes of the thread are then dropped
+		static inline ndm::TraceBuffer * acquire_buffer() noexcept
+		{
+			const std::uint32_t thread_id = s_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+			for (ndm::TraceBuffer * buffer = s_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->m_next)
+			{
+				bool used = false;
+				if (buffer->m_used.compare_exchange_strong(used, true, std::memory_order_acquire, std::memory_order_relaxed) == false)
+					continue;
+
+				// The scopes of the ended thread are no longer exported
+				buffer->m_thread_name.store(nullptr, std::memory_order_relaxed);
+				buffer->m_thread_id.store(thread_id, std::memory_order_relaxed);
+				buffer->m_first.store(buffer->m_head.load(std::memory_order_relaxed), std::memory_order_release);
+				return buffer;
+			}
+
+			ndm::TraceBuffer * buffer = new (std::nothrow) ndm::TraceBuffer();
+			if (buffer == nullptr)
+				return nullptr;
+
+			buffer->m_thread_id.store(thread_id, std::memory_order_relaxed);
+			buffer->m_next = s_buffers.load(std::memory_order_relaxed);
+			while (s_buffers.compare_exchange_weak(buffer->m_next, buffer, std::memory_order_release, std::memory_order_relaxed) == false);
+			return buffer;
+		}
+
+		// Owner of the buffer of a thread, it releases the buffer when the thread ends
+		struct ThreadBuffer
+		{
+			ndm::TraceBuffer * buffer;
+
+			inline ThreadBuffer() noexcept :
+				buffer(acquire_buffer())
+			{
+			}
+
+			inline ~ThreadBuffer()
+			{
+				if (buffer != nullptr)
+					buffer->m_used.store(false, std::memory_order_release);
+			}
+		};
+
+		// Write a time in microseconds with the nanoseconds as decimals
+		static inline void write_microseconds(std::ostream & stream, const std::int64_t nanoseconds)
+		{
+			const char previous_fill = stream.fill('0');
+			stream << nanoseconds / 1000 << '.';
+			stream.width(3);
+			stream << nanoseconds % 1000;
+			stream.fill(previous_fill);
+		}
+
+	public:
+
+		/**
+		* This method return the buffer of the calling thread, given by the first call of the thread.
+		* @return TraceBuffer * The buffer of the thread, null when it can't be allocated
+		*/
+		static inline ndm::TraceBuffer * get_thread_buffer() noexcept
+		{
+			thread_local const ThreadBuffer thread_buffer;
+			return thread_buffer.buffer;
+		}
+
+		/**
+		* This method return the number of buffers allocated, not more than the number of threads that recorded scopes at 
+		* the same time.
+		* @return std::size_t The number of buffers
+		*/
+		static inline std::size_t get_buffer_count() noexcept
+		{
+			std::size_t count = 0;
+			for (ndm::TraceBuffer * buffer = s_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->m_next)
+				count++;
+			return count;
+		}
+
+		/**
+		* This method return the clock of the scopes, the same clock can be used to place other spans on the timeline.
+		* @return std::int64_t The time in nanoseconds
+		*/
+		static inline std::int64_t now() noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/**
+		* This method name the calling thread in the exported trace.
+		* @param name The name of the thread, a string that lives until the export
+		*/
+		static inline void set_thread_name(const char * name) noexcept
+		{
+			ndm::TraceBuffer * buffer = get_thread_buffer();
+			if (buffer != nullptr)
+				buffer->m_thread_name.store(name, std::memory_order_relaxed);
+		}
+
+		/**
+		* This method write the scopes of all the threads in the Chrome trace event format. It can be called while the
+		* threads record scopes, the scopes overwritten during the copy are dropped.
+		* @param stream The stream where the JSON is written
+		* @param process_id The process id of the events, to merge the trace with other traces of the process
+		*/
+		static inline void export_chrome_trace(std::ostream & stream, const std::uint32_t process_id = 1)
+		{
+			struct Event
+			{
+				const char * name;
+				std::int64_t start;
+				std::int64_t duration;
+			};
+
+			bool first = true;
+			std::vector<Event> events;
+			stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+			for (ndm::TraceBuffer * buffer = s_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->m_next)
+			{
+				const std::uint32_t thread_id = buffer->m_thread_id.load(std::memory_order_relaxed);
+				const char * thread_name = buffer->m_thread_name.load(std::memory_order_relaxed);
+				if (thread_name != nullptr)
+				{
+					stream << (first == true ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << process_id << ",\"tid\":"
+						   << thread_id << ",\"args\":{\"name\":\"" << thread_name << "\"}}";
+					first = false;
+				}
+
+				// Copy the scopes of the current thread of the buffer, then only keep the ones that the thread didn't overwrite
+				// during the copy
+				const std::uint64_t thread_first = buffer->m_first.load(std::memory_order_acquire);
+				const std::uint64_t head = buffer->m_head.load(std::memory_order_acquire);
+				const std::uint64_t begin = std::max(thread_first, head > TraceBuffer::capacity ? head - TraceBuffer::capacity : 0);
+				events.clear();
+				for (std::uint64_t i = begin; i < head; i++)
+				{
+					const ndm::TraceRecord & record = buffer->m_records[i & (TraceBuffer::capacity - 1)];
+					events.push_back(Event { record.name.load(std::memory_order_relaxed), record.start.load(std::memory_order_relaxed),
+											 record.duration.load(std::memory_order_relaxed) });
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+				const std::uint64_t new_head = buffer->m_head.load(std::memory_order_relaxed);
+				const std::uint64_t valid = new_head > TraceBuffer::capacity ? new_head - TraceBuffer::capacity : 0;
+
+				for (std::uint64_t i = std::max(begin, valid); i < head; i++)
+				{
+					const Event & event = events[i - begin];
+					stream << (first == true ? "" : ",") << "\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":" << process_id
+						   << ",\"tid\":" << thread_id << ",\"ts\":";
+					write_microseconds(stream, event.start);
+					stream << ",\"dur\":";
+					write_microseconds(stream, event.duration);
+					stream << "}";
+					first = false;
+				}
+			}
+			stream << "\n]}\n";
+		}
+	};
+
+	/**
+	* This class record the time between its construction and its destruction in the buffer of the thread.
+	*/
+	class TraceScope
+	{
+	private:
+
+		// Attributes
+		const char * m_name;
+		std::int64_t m_start;
+
+	public:
+
+		// Constructor
+		inline explicit TraceScope(const char * name) noexcept :
+			m_name(name),
+			m_start(ndm::Trace::now())
+		{
+		}
+
+		/**
+		* No copy constructors
+		*/
+		inline TraceScope(TraceScope &) = delete;
+		inline TraceScope(const TraceScope &) = delete;
+
+		// Destructor
+		inline ~TraceScope() noexcept
+		{
+			ndm::TraceBuffer * buffer = ndm::Trace::get_thread_buffer();
+			if (buffer != nullptr)
+				buffer->push(m_name, m_start, ndm::Trace::now() - m_start);
+		}
+	};
+}
+
+#define NDM_TRACE_CONCAT_IMPL(a, b) a##b
+#define NDM_TRACE_CONCAT(a, b) NDM_TRACE_CONCAT_IMPL(a, b)
+
+/**
+* Record the time until the end of the current scope, the name must be a string literal.
+*/
+#define NDM_TRACE_SCOPE(name) const ::ndm::TraceScope NDM_TRACE_CONCAT(ndm_trace_scope_, __LINE__)(name)
+
+/**
+* Name the calling thread in the exported trace, the name must be a string literal.
+*/
+#define NDM_TRACE_THREAD_NAME(name) ::ndm::Trace::set_thread_name(name)
+
+#else
+
+#define NDM_TRACE_SCOPE(name) static_cast<void>(0)
+#define NDM_TRACE_THREAD_NAME(name) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,269 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// STD includes
+#include <mutex>
+#include <algorithm>
+
+// Linux includes
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/opengl/gl_extensions.hpp>
+
+// The surfaceless display of the process and the number of its users
+static std::mutex egl_display_mutex;
+static EGLDisplay egl_display = EGL_NO_DISPLAY;
+static std::uint64_t egl_display_references = 0;
+
+EGLDisplay ndm::egl_acquire_display()
+{
+	std::lock_guard<std::mutex> lock(egl_display_mutex);
+
+	if (egl_display_references == 0)
+	{
+		// The surfaceless platform of Mesa renders without window system and without GPU (llvmpipe), the default display 
+		// is used when the platform is not available
+		const char * client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		if (ndm::eglGetPlatformDisplayEXT == nullptr && ndm::gl_has_extension(client_extensions, "EGL_EXT_platform_base") == true)
+			ndm::eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+		egl_display = EGL_NO_DISPLAY;
+		if (ndm::eglGetPlatformDisplayEXT != nullptr && ndm::gl_has_extension(client_extensions, "EGL_MESA_platform_surfaceless") == true)
+			egl_display = ndm::eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+
+		if (egl_display == EGL_NO_DISPLAY)
+			egl_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		if (egl_display == EGL_NO_DISPLAY)
+			throw std::runtime_error("Can't get an EGL display !");
+
+		EGLint major = 0;
+		EGLint minor = 0;
+		if (eglInitialize(egl_display, &major, &minor) == EGL_FALSE)
+		{
+			egl_display = EGL_NO_DISPLAY;
+			throw std::runtime_error("Can't initialize the EGL display !");
+		}
+	}
+
+	egl_display_references++;
+	return egl_display;
+}
+
+void ndm::egl_release_display()
+{
+	std::lock_guard<std::mutex> lock(egl_display_mutex);
+
+	if (egl_display_references == 0)
+		return;
+
+	egl_display_references--;
+	if (egl_display_references == 0)
+	{
+		eglTerminate(egl_display);
+		egl_display = EGL_NO_DISPLAY;
+	}
+}
+
+void ndm::Display::load(const std::string_view title, const std::uint64_t width, const std::uint64_t height, const bool visible)
+{
+	if (m_loaded == true)
+		throw std::runtime_error("The display is already loaded !");
+
+	// A headless display has no title and is never visible
+	(void) title;
+	(void) visible;
+
+	m_egl_display = ndm::egl_acquire_display();
+
+	// Create the event file descriptor used by other threads to wake up wait_events()
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wake_fd < 0)
+	{
+		ndm::egl_release_display();
+		m_egl_display = EGL_NO_DISPLAY;
+		throw std::runtime_error("Can't create the wake event !");
+	}
+
+	// Clear structs, a headless display has no decorations so the outer size is the client size
+	m_events.clear();
+	m_geometry.x = 0;
+	m_geometry.y = 0;
+	m_geometry.width = m_geometry.client_width = static_cast<std::int64_t>(width);
+	m_geometry.height = m_geometry.client_height = static_cast<std::int64_t>(height);
+	m_egl_reported_geometry = m_geometry;
+	m_closed = false;
+
+	// The renderers created before the first call to catch_events() have the initial size
+	m_framebuffer_width = m_geometry.client_width;
+	m_framebuffer_height = m_geometry.client_height;
+
+	// Set loaded
+	m_loaded = true;
+}
+
+void ndm::Display::set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor, const ndm::MonitorCapabilities & capabilities)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	// There is no monitor to show a headless display on
+	(void) mode;
+	(void) monitor;
+	(void) capabilities;
+}
+
+bool ndm::Display::has_focus() const
+{
+	// A headless display is always the active one, so the render loops that pause without focus keep running
+	return m_loaded;
+}
+
+void ndm::Display::set_resizable_by_user(const bool resizable)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	// There is no user to resize a headless display
+	(void) resizable;
+}
+
+void ndm::Display::set_sync_resize(const bool enabled)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	// There is no window manager to wait for the frames, the resizes are only counted
+	m_sync_resize.store(enabled, std::memory_order_release);
+}
+
+void ndm::Display::acknowledge_resize() noexcept
+{
+	m_resize_presented.store(m_resize_seen, std::memory_order_release);
+}
+
+void ndm::Display::pump_events(const std::chrono::milliseconds timeout) noexcept
+{
+	if (m_loaded == false || m_closed == true)
+		return;
+
+	// Only another thread can wake up a headless display, unless a change of geometry is waiting to be reported
+	const bool pending = m_geometry.x != m_egl_reported_geometry.x || m_geometry.y != m_egl_reported_geometry.y ||
+		m_geometry.client_width != m_egl_reported_geometry.client_width || m_geometry.client_height != m_egl_reported_geometry.client_height;
+
+	if (timeout.count() != 0 && pending == false)
+	{
+		pollfd fds[1] = {};
+		fds[0].fd = m_wake_fd;
+		fds[0].events = POLLIN;
+
+		const int milliseconds = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+		if (poll(fds, 1, milliseconds) > 0 && (fds[0].revents & POLLIN) != 0)
+		{
+			// Reset the counter of the wake event
+			eventfd_t value = 0;
+			eventfd_read(m_wake_fd, &value);
+		}
+	}
+
+	// There is no window system to send events, the changes of geometry since the last call are reported like a window would
+	if (m_geometry.client_width != m_egl_reported_geometry.client_width || m_geometry.client_height != m_egl_reported_geometry.client_height)
+	{
+		m_events.push(ndm::DisplayEventType::RESIZED, m_geometry.x, m_geometry.y, m_geometry.client_width, m_geometry.client_height);
+		m_resize_count.fetch_add(1, std::memory_order_release);
+	}
+
+	if (m_geometry.x != m_egl_reported_geometry.x || m_geometry.y != m_egl_reported_geometry.y)
+		m_events.push(ndm::DisplayEventType::MOVED, m_geometry.x, m_geometry.y, m_geometry.client_width, m_geometry.client_height);
+
+	m_egl_reported_geometry = m_geometry;
+}
+
+void ndm::Display::wake() noexcept
+{
+	if (m_wake_fd >= 0)
+		eventfd_write(m_wake_fd, 1);
+}
+
+void ndm::Display::unload()
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (m_egl_display == EGL_NO_DISPLAY)
+		throw std::runtime_error("There is no EGL display !");
+
+	ndm::egl_release_display();
+	m_egl_display = EGL_NO_DISPLAY;
+
+	if (m_keep_wake_handle == false)
+		release_wake_handle();
+
+	m_loaded = false;
+}
+
+void ndm::Display::release_wake_handle() noexcept
+{
+	if (m_wake_fd >= 0)
+		close(m_wake_fd);
+	m_wake_fd = -1;
+}
+
+void ndm::Display::set_title(const std::string_view title)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	(void) title;
+}
+
+void ndm::Display::set_visible(const bool visible)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	(void) visible;
+}
+
+void ndm::Display::set_geometry(const std::int64_t x, const std::int64_t y, const std::uint64_t width, const std::uint64_t height)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	// The OpenGL context resizes its pbuffer to the client size on the next swap
+	m_geometry.x = x;
+	m_geometry.y = y;
+	m_geometry.width = m_geometry.client_width = std::max<std::int64_t>(1, static_cast<std::int64_t>(width));
+	m_geometry.height = m_geometry.client_height = std::max<std::int64_t>(1, static_cast<std::int64_t>(height));
+}
+
+void ndm::Display::set_x(const std::uint64_t x)
+{
+	set_geometry(static_cast<std::int64_t>(x), get_y(), static_cast<std::uint64_t>(get_width()), static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_y(const std::uint64_t y)
+{
+	set_geometry(get_x(), static_cast<std::int64_t>(y), static_cast<std::uint64_t>(get_width()), static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_width(const std::uint64_t width)
+{
+	set_geometry(get_x(), get_y(), width, static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_height(const std::uint64_t height)
+{
+	set_geometry(get_x(), get_y(), static_cast<std::uint64_t>(get_width()), height);
+}
+
+EGLDisplay ndm::Display::get_egl_display() const
+{
+	return m_egl_display;
+}
+
+#endif
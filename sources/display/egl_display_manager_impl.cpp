@@ -0,0 +1,96 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// Linux includes
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// NDM includes
+#include <ndm/display/display_manager.hpp>
+
+void ndm::DisplayManager::load()
+{
+	if (m_loaded == true)
+		throw std::runtime_error("The display manager is already loaded !");
+
+	// Create the event file descriptor used by other threads to wake up wait_events()
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wake_fd < 0)
+		throw std::runtime_error("Can't create the wake event !");
+
+	m_loaded = true;
+}
+
+void ndm::DisplayManager::unload()
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display manager is not loaded !");
+
+	close(m_wake_fd);
+	m_wake_fd = -1;
+
+	m_loaded = false;
+}
+
+const std::vector<ndm::DisplayManagerEvent> & ndm::DisplayManager::catch_events() noexcept
+{
+	NDM_TRACE_SCOPE("DisplayManager::catch_events");
+
+	// There is no window system, each display reports the changes of its geometry
+	clear_events();
+	for (ndm::Display * display : m_displays)
+		display->pump_events(std::chrono::milliseconds(0));
+
+	collect_events();
+	return m_events;
+}
+
+const std::vector<ndm::DisplayManagerEvent> & ndm::DisplayManager::wait_events(const std::chrono::milliseconds timeout) noexcept
+{
+	NDM_TRACE_SCOPE("DisplayManager::wait_events");
+
+	if (m_loaded == true)
+	{
+		// Only another thread can wake up headless displays, unless a change of geometry is waiting to be reported
+		bool pending = false;
+		m_poll_fds.clear();
+		m_poll_fds.push_back(pollfd { m_wake_fd, POLLIN, 0 });
+		for (ndm::Display * display : m_displays)
+		{
+			if (display->m_loaded == false || display->m_closed == true)
+				continue;
+
+			const ndm::DisplayGeometry & geometry = display->m_geometry;
+			const ndm::DisplayGeometry & reported = display->m_egl_reported_geometry;
+			if (geometry.x != reported.x || geometry.y != reported.y || geometry.client_width != reported.client_width || geometry.client_height != reported.client_height)
+				pending = true;
+
+			// The wake event of a display also wakes up the manager
+			m_poll_fds.push_back(pollfd { display->m_wake_fd, POLLIN, 0 });
+		}
+
+		const int milliseconds = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+		if (pending == false && poll(m_poll_fds.data(), static_cast<nfds_t>(m_poll_fds.size()), milliseconds) > 0)
+		{
+			// Reset the counters of the wake events
+			for (const pollfd & fd : m_poll_fds)
+			{
+				if ((fd.revents & POLLIN) == 0)
+					continue;
+
+				eventfd_t value = 0;
+				eventfd_read(fd.fd, &value);
+			}
+		}
+	}
+
+	return catch_events();
+}
+
+void ndm::DisplayManager::wake() noexcept
+{
+	if (m_wake_fd >= 0)
+		eventfd_write(m_wake_fd, 1);
+}
+
+#endif
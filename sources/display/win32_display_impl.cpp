@@ -4,8 +4,105 @@
 // NDM includes
 #include <ndm/display/display.hpp>
 
+// Update the outer rect of the cached geometry, the client size is given by the events
+static void win32_update_window_rect(HWND handle, ndm::DisplayGeometry & geometry)
+{
+	RECT rect = { 0, 0, 0, 0 };
+	if (GetWindowRect(handle, &rect) == FALSE)
+		return;
+
+	geometry.x = rect.left;
+	geometry.y = rect.top;
+	geometry.width = rect.right - rect.left;
+	geometry.height = rect.bottom - rect.top;
+}
+
+// Make the process per-monitor DPI aware (v2) before its first window is created : the client area is measured in physical 
+// pixels and the window receives WM_DPICHANGED when it moves to a monitor with another scale. The functions are loaded 
+// from user32 because they are missing before Windows 10, the older systems are only aware of the DPI of the system
+static void win32_enable_per_monitor_dpi()
+{
+	if (ndm::win32GetDpiForWindow != nullptr)
+		return;
+
+	HMODULE user32 = GetModuleHandleA("user32.dll");
+	if (user32 != nullptr)
+	{
+		ndm::win32SetProcessDpiAwarenessContext = (ndm::PFNSETPROCESSDPIAWARENESSCONTEXTPROC) GetProcAddress(user32, "SetProcessDpiAwarenessContext");
+		ndm::win32GetDpiForWindow = (ndm::PFNGETDPIFORWINDOWPROC) GetProcAddress(user32, "GetDpiForWindow");
+	}
+
+	// The call fails when the awareness is already set by the manifest of the application, which is kept
+	if (ndm::win32SetProcessDpiAwarenessContext != nullptr)
+		ndm::win32SetProcessDpiAwarenessContext(ndm::WIN32_DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+	else
+		SetProcessDPIAware();
+}
+
+// Get the DPI of the monitor of a window, or the DPI of the system before Windows 10
+static std::uint32_t win32_get_dpi(HWND handle, HDC device_context)
+{
+	UINT dpi = 0;
+	if (ndm::win32GetDpiForWindow != nullptr)
+		dpi = ndm::win32GetDpiForWindow(handle);
+	else if (device_context != nullptr)
+		dpi = static_cast<UINT>(GetDeviceCaps(device_context, LOGPIXELSX));
+
+	return dpi != 0 ? static_cast<std::uint32_t>(dpi) : ndm::DEFAULT_DPI;
+}
+
+// Maximum time the window procedure waits for the frame of a synchronous resize, a late renderer doesn't freeze the window
+static constexpr DWORD win32_sync_resize_timeout = 100;
+
+// Push the relative motion of a raw input of the mouse
+static void win32_push_raw_input(const RAWINPUT & raw_input, ndm::DisplayEvents & events)
+{
+	if (raw_input.header.dwType != RIM_TYPEMOUSE)
+		return;
+
+	// Tablets and remote desktops send absolute positions, they are already reported by MOUSE_MOVED
+	const RAWMOUSE & mouse = raw_input.data.mouse;
+	if ((mouse.usFlags & MOUSE_MOVE_ABSOLUTE) != 0)
+		return;
+
+	if (mouse.lLastX != 0 || mouse.lLastY != 0)
+		events.push(ndm::DisplayEventType::MOUSE_RAW_MOTION, mouse.lLastX, mouse.lLastY);
+}
+
+// Read all the raw inputs waiting in the queue with a single call instead of a message for each of them, the WM_INPUT 
+// messages read are removed from the queue
+static void win32_read_raw_input_buffer(std::vector<std::uint64_t> & buffer, ndm::DisplayEvents & events)
+{
+	if (buffer.empty() == true)
+		return;
+
+	while (true)
+	{
+		UINT size = static_cast<UINT>(buffer.size() * sizeof(std::uint64_t));
+		const UINT count = GetRawInputBuffer(reinterpret_cast<RAWINPUT *>(buffer.data()), &size, sizeof(RAWINPUTHEADER));
+		if (count == 0 || count == static_cast<UINT>(-1))
+			break;
+
+		RAWINPUT * raw_input = reinterpret_cast<RAWINPUT *>(buffer.data());
+		for (UINT i = 0; i < count; i++)
+		{
+			win32_push_raw_input(*raw_input, events);
+			raw_input = NEXTRAWINPUTBLOCK(raw_input);
+		}
+	}
+}
+
+// Push a button of the mouse with the position of the cursor
+static void win32_push_mouse_button(ndm::DisplayEvents & events, const bool pressed, const std::uint32_t button, const LPARAM lParam)
+{
+	events.push(pressed == true ? ndm::DisplayEventType::MOUSE_BUTTON_PRESSED : ndm::DisplayEventType::MOUSE_BUTTON_RELEASED,
+				static_cast<short>(LOWORD(lParam)), static_cast<short>(HIWORD(lParam)), 0, 0, 0, button);
+}
+
 LRESULT CALLBACK ndm::win32_process_events(HWND m_handle, UINT message, WPARAM wParam, LPARAM lParam)
 {
+	NDM_TRACE_SCOPE("win32_process_events");
+
 	ndm::Display * current_display = (ndm::Display *) GetWindowLongPtr(m_handle, GWLP_USERDATA);
 	if(current_display == nullptr)
 		return DefWindowProc(m_handle, message, wParam, lParam);
@@ -14,16 +111,144 @@ LRESULT CALLBACK ndm::win32_process_events(HWND m_handle, UINT message, WPARAM w
 	switch (message)
 	{
 		case WM_CLOSE:
-			events.closed = true;
+			events.push(ndm::DisplayEventType::CLOSED);
+			break;
+		case WM_DESTROY:
+			current_display->m_closed = true;
 			break;
 		case WM_SIZE:
-			if (wParam == SIZE_RESTORED) events.resized = true;
-			if (wParam == SIZE_MINIMIZED) events.minimized = true;
-			if (wParam == SIZE_MAXIMIZED) events.maximized = true;
+		{
+			current_display->m_geometry.client_width = LOWORD(lParam);
+			current_display->m_geometry.client_height = HIWORD(lParam);
+			win32_update_window_rect(m_handle, current_display->m_geometry);
+			if (wParam == SIZE_RESTORED) events.push(ndm::DisplayEventType::RESIZED, 0, 0, LOWORD(lParam), HIWORD(lParam));
+			if (wParam == SIZE_MINIMIZED) events.push(ndm::DisplayEventType::MINIMIZED, 0, 0, LOWORD(lParam), HIWORD(lParam));
+			if (wParam == SIZE_MAXIMIZED) events.push(ndm::DisplayEventType::MAXIMIZED, 0, 0, LOWORD(lParam), HIWORD(lParam));
+			if (wParam != SIZE_RESTORED && wParam != SIZE_MAXIMIZED)
+				break;
+
+			// The window is shown by DWM when the message returns, during the resize loop the frame of the new size is waited
+			// for, unless the frames are presented by this thread (it can't render while the system runs the loop)
+			const std::uint64_t resize = current_display->m_resize_count.fetch_add(1, std::memory_order_release) + 1;
+			const DWORD presenting_thread = current_display->m_win32_presenting_thread.load(std::memory_order_relaxed);
+			if (current_display->m_sync_resize.load(std::memory_order_acquire) == true && current_display->m_win32_sizing == true && 
+				presenting_thread != 0 && presenting_thread != GetCurrentThreadId())
+			{
+				const ULONGLONG deadline = GetTickCount64() + win32_sync_resize_timeout;
+				while (current_display->m_resize_presented.load(std::memory_order_acquire) < resize)
+				{
+					const ULONGLONG now = GetTickCount64();
+					if (now >= deadline || WaitForSingleObject(current_display->m_win32_resize_event, static_cast<DWORD>(deadline - now)) != WAIT_OBJECT_0)
+						break;
+				}
+			}
+			break;
+		}
+		case WM_ENTERSIZEMOVE:
+			current_display->m_win32_sizing = true;
+			break;
+		case WM_EXITSIZEMOVE:
+			current_display->m_win32_sizing = false;
 			break;
 		case WM_MOVE:
-			events.moved = true;
+			// The message gives the origin of the client area, the event has the outer position like the geometry
+			win32_update_window_rect(m_handle, current_display->m_geometry);
+			events.push(ndm::DisplayEventType::MOVED, current_display->m_geometry.x, current_display->m_geometry.y);
+			break;
+		case WM_SETFOCUS:
+			if (current_display->m_win32_focused == false)
+				events.push(ndm::DisplayEventType::FOCUS_GAINED);
+			current_display->m_win32_focused = true;
+			break;
+		case WM_KILLFOCUS:
+			// The keys and the buttons held are released by the input state, their releases are sent to the other window
+			if (current_display->m_win32_focused == true)
+				events.push(ndm::DisplayEventType::FOCUS_LOST);
+			current_display->m_win32_focused = false;
+			break;
+		case WM_ACTIVATEAPP:
+			if (wParam == FALSE && current_display->m_win32_focused == true)
+			{
+				events.push(ndm::DisplayEventType::FOCUS_LOST);
+				current_display->m_win32_focused = false;
+			}
+
+			// The exclusive mode is only kept while the application is active, alt-tab shows the desktop in its own mode
+			if (current_display->m_display_mode == ndm::DisplayMode::EXCLUSIVE_FULLSCREEN)
+			{
+				if (wParam == FALSE)
+				{
+					current_display->restore_exclusive_mode();
+					ShowWindow(m_handle, SW_MINIMIZE);
+				} else if (current_display->m_win32_mode_changed == false) {
+					ShowWindow(m_handle, SW_RESTORE);
+					current_display->apply_exclusive_mode();
+				}
+			}
+			break;
+		case WM_KEYDOWN:
+		case WM_SYSKEYDOWN:
+		case WM_KEYUP:
+		case WM_SYSKEYUP:
+		{
+			// The scan code is in the bits 16 to 23, the bit 24 marks the extended keys (right control, arrows...)
+			const std::uint32_t scan_code = static_cast<std::uint32_t>((lParam >> 16) & 0xFF) | ((lParam & (1 << 24)) != 0 ? 0xE000 : 0);
+			const bool pressed = message == WM_KEYDOWN || message == WM_SYSKEYDOWN;
+			events.push(pressed == true ? ndm::DisplayEventType::KEY_PRESSED : ndm::DisplayEventType::KEY_RELEASED, 0, 0, 0, 0, scan_code, static_cast<std::uint32_t>(wParam));
+			break;
+		}
+		case WM_LBUTTONDOWN:
+		case WM_LBUTTONUP:
+			win32_push_mouse_button(events, message == WM_LBUTTONDOWN, 1, lParam);
+			break;
+		case WM_MBUTTONDOWN:
+		case WM_MBUTTONUP:
+			win32_push_mouse_button(events, message == WM_MBUTTONDOWN, 2, lParam);
+			break;
+		case WM_RBUTTONDOWN:
+		case WM_RBUTTONUP:
+			win32_push_mouse_button(events, message == WM_RBUTTONDOWN, 3, lParam);
+			break;
+		case WM_XBUTTONDOWN:
+		case WM_XBUTTONUP:
+			win32_push_mouse_button(events, message == WM_XBUTTONDOWN, 3 + GET_XBUTTON_WPARAM(wParam), lParam);
+			break;
+		case WM_MOUSEWHEEL:
+			events.push(ndm::DisplayEventType::MOUSE_WHEEL, 0, GET_WHEEL_DELTA_WPARAM(wParam));
+			break;
+		case WM_MOUSEHWHEEL:
+			events.push(ndm::DisplayEventType::MOUSE_WHEEL, GET_WHEEL_DELTA_WPARAM(wParam), 0);
+			break;
+		case WM_MOUSEMOVE:
+			events.push(ndm::DisplayEventType::MOUSE_MOVED, static_cast<short>(LOWORD(lParam)), static_cast<short>(HIWORD(lParam)));
+			break;
+		case WM_INPUT:
+		{
+			// The input of this message is read alone, the inputs still waiting in the queue are read in a batch
+			RAWINPUT raw_input = {};
+			UINT size = sizeof(RAWINPUT);
+			if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &raw_input, &size, sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1))
+				win32_push_raw_input(raw_input, events);
+			win32_read_raw_input_buffer(current_display->m_win32_raw_input_buffer, events);
 			break;
+		}
+		case WM_DISPLAYCHANGE:
+			if (events.contains(ndm::DisplayEventType::MONITORS_CHANGED) == false)
+				events.push(ndm::DisplayEventType::MONITORS_CHANGED);
+			break;
+		case ndm::WIN32_WM_DPICHANGED:
+		{
+			// The window takes the rect suggested by the system to keep its physical size on the new monitor, the client size 
+			// is updated by the WM_SIZE sent during the move
+			const RECT * suggested_rect = reinterpret_cast<const RECT *>(lParam);
+			current_display->m_dpi = static_cast<std::uint32_t>(HIWORD(wParam));
+			SetWindowPos(m_handle, nullptr, suggested_rect->left, suggested_rect->top, 
+						 suggested_rect->right - suggested_rect->left, suggested_rect->bottom - suggested_rect->top, 
+						 SWP_NOZORDER | SWP_NOACTIVATE);
+			events.push(ndm::DisplayEventType::SCALE_CHANGED, current_display->m_dpi, 0, 
+						current_display->m_geometry.client_width, current_display->m_geometry.client_height);
+			return 0;
+		}
 	}
 
 	return DefWindowProc(m_handle, message, wParam, lParam);
@@ -55,6 +280,9 @@ void ndm::Display::load(const std::string_view title, const std::uint64_t width,
 			throw std::exception("Can't register the window class !");
 	}
 
+	// The DPI awareness must be set before the creation of the window
+	win32_enable_per_monitor_dpi();
+
 	// Create the window
 	m_handle = CreateWindowExA(0, "NDMClass", "Application",
 							   WS_OVERLAPPEDWINDOW, 
@@ -68,14 +296,51 @@ void ndm::Display::load(const std::string_view title, const std::uint64_t width,
 	SetWindowLongPtr(m_handle, GWLP_USERDATA, (LONG_PTR) this);
 
 	// Clear structs
-	std::memset(&m_events, 0, sizeof(DisplayEvents));
+	m_events.clear();
 	std::memset(&m_messages, 0, sizeof(MSG));
+	m_closed = false;
+	m_win32_focused = false;
+
+	// Fill the cached geometry, the events received during the creation were not bound to this display yet
+	RECT client_rect = { 0, 0, 0, 0 };
+	GetClientRect(m_handle, &client_rect);
+	m_geometry.client_width = client_rect.right - client_rect.left;
+	m_geometry.client_height = client_rect.bottom - client_rect.top;
+	win32_update_window_rect(m_handle, m_geometry);
+
+	// Create the auto-reset event used by other threads to wake up wait_events()
+	m_wake_event = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+	if (m_wake_event == nullptr)
+		throw std::exception("Can't create the wake event !");
+
+	// Create the auto-reset event signaled when a frame is presented during a synchronous resize
+	m_win32_resize_event = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+	if (m_win32_resize_event == nullptr)
+		throw std::exception("Can't create the resize event !");
+
+	// Ask the relative motion of the mouse with raw input, the registration is shared by the windows of the process and 
+	// follows the focused window. A high rate mouse sends thousands of inputs per second, so they are read in batches
+	RAWINPUTDEVICE raw_input_device = {};
+	raw_input_device.usUsagePage = 0x01; // Generic desktop controls
+	raw_input_device.usUsage = 0x02; // Mouse
+	raw_input_device.dwFlags = 0;
+	raw_input_device.hwndTarget = nullptr;
+	if (RegisterRawInputDevices(&raw_input_device, 1, sizeof(RAWINPUTDEVICE)) == FALSE)
+		throw std::exception("Can't register the raw input of the mouse !");
+	m_win32_raw_input_buffer.assign(8192, 0);
 
 	// Get the device context
 	m_device_context = GetDC(m_handle);
 	if (m_device_context == nullptr)
 		throw std::exception("Can't retrieve the device context !");
 
+	// Get the DPI of the monitor of the window, the next changes are sent by WM_DPICHANGED
+	m_dpi = win32_get_dpi(m_handle, m_device_context);
+
+	// The renderers created before the first call to catch_events() have the initial size
+	m_framebuffer_width = m_geometry.client_width;
+	m_framebuffer_height = m_geometry.client_height;
+
 	// Set loaded
 	m_loaded = true;
 
@@ -84,28 +349,97 @@ void ndm::Display::load(const std::string_view title, const std::uint64_t width,
 	set_title(title);
 }
 
-void ndm::Display::set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor)
+bool ndm::Display::apply_exclusive_mode() noexcept
+{
+	if (ChangeDisplaySettingsExA(m_win32_fullscreen_device.c_str(), &m_win32_fullscreen_mode, nullptr, CDS_FULLSCREEN, nullptr) != DISP_CHANGE_SUCCESSFUL)
+		return false;
+	m_win32_mode_changed = true;
+
+	// The position of the monitor on the desktop can change with its mode
+	DEVMODEA current_mode = {};
+	current_mode.dmSize = sizeof(DEVMODEA);
+	EnumDisplaySettingsA(m_win32_fullscreen_device.c_str(), ENUM_CURRENT_SETTINGS, &current_mode);
+
+	SetWindowLongPtr(m_handle, GWL_STYLE, WS_POPUP);
+	SetWindowPos(m_handle, HWND_TOP, current_mode.dmPosition.x, current_mode.dmPosition.y, static_cast<int>(m_win32_fullscreen_mode.dmPelsWidth), 
+				 static_cast<int>(m_win32_fullscreen_mode.dmPelsHeight), SWP_SHOWWINDOW | SWP_FRAMECHANGED);
+	return true;
+}
+
+void ndm::Display::restore_exclusive_mode() noexcept
+{
+	if (m_win32_mode_changed == false)
+		return;
+
+	// A null mode restores the mode saved in the registry, which is the mode of the desktop
+	ChangeDisplaySettingsExA(m_win32_fullscreen_device.c_str(), nullptr, nullptr, 0, nullptr);
+	m_win32_mode_changed = false;
+}
+
+void ndm::Display::set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor, const ndm::MonitorCapabilities & capabilities)
 {
 	if(m_loaded == false)
 		throw std::exception("The display is not loaded !");
 
+	// The placement is saved when the window leaves the windowed mode, so it comes back at the same place
+	if (m_display_mode == ndm::DisplayMode::WINDOWED && mode != ndm::DisplayMode::WINDOWED)
+	{
+		m_win32_saved_placement.length = sizeof(WINDOWPLACEMENT);
+		GetWindowPlacement(m_handle, &m_win32_saved_placement);
+		m_win32_saved_style = GetWindowLongPtr(m_handle, GWL_STYLE);
+	}
+
+	// The mode of the desktop is restored before leaving the exclusive mode or changing its monitor
+	if (m_win32_mode_changed == true && (mode != ndm::DisplayMode::EXCLUSIVE_FULLSCREEN || m_win32_fullscreen_device != monitor.get_name()))
+		restore_exclusive_mode();
+
+	// The geometry of the monitor is precomputed by its mode table
+	const auto [x, y] = monitor.get_min_position();
 	switch (mode)
 	{
+	case ndm::DisplayMode::EXCLUSIVE_FULLSCREEN:
+	{
+		m_win32_fullscreen_device = monitor.get_name();
+		std::memset(&m_win32_fullscreen_mode, 0, sizeof(DEVMODEA));
+		m_win32_fullscreen_mode.dmSize = sizeof(DEVMODEA);
+		m_win32_fullscreen_mode.dmPelsWidth = capabilities.m_width;
+		m_win32_fullscreen_mode.dmPelsHeight = capabilities.m_height;
+		m_win32_fullscreen_mode.dmDisplayFrequency = capabilities.refresh_rate;
+		m_win32_fullscreen_mode.dmFields = DM_PELSWIDTH | DM_PELSHEIGHT | (capabilities.refresh_rate != 0 ? DM_DISPLAYFREQUENCY : 0);
+		if (apply_exclusive_mode() == false)
+			throw std::exception("Can't change the mode of the monitor !");
+		break;
+	}
 	case ndm::DisplayMode::FULLSCREEN:
+	{
+		// The window covers the monitor in its current mode, which is not always the largest one
+		MONITORINFO monitor_info = {};
+		monitor_info.cbSize = sizeof(MONITORINFO);
+		if (GetMonitorInfoA(MonitorFromPoint(POINT { static_cast<LONG>(x), static_cast<LONG>(y) }, MONITOR_DEFAULTTONEAREST), &monitor_info) == FALSE)
+			throw std::exception("Can't retrieve the area of the monitor !");
+
+		const RECT & area = monitor_info.rcMonitor;
 		SetWindowLongPtr(m_handle, GWL_STYLE, WS_POPUP);
-		SetWindowPos(m_handle, HWND_TOP, 
-					std::get<0>(monitor.get_min_position()), std::get<1>(monitor.get_min_position()), 
-					std::get<0>(monitor.get_max_size()), std::get<1>(monitor.get_max_size()), 
-					SWP_SHOWWINDOW);
+		SetWindowPos(m_handle, HWND_TOP, area.left, area.top, area.right - area.left, area.bottom - area.top, SWP_SHOWWINDOW | SWP_FRAMECHANGED);
 		break;
+	}
 	case ndm::DisplayMode::WINDOWED:
-		SetWindowLongPtr(m_handle, GWL_STYLE, WS_OVERLAPPEDWINDOW);
-		SetWindowPos(m_handle, HWND_BOTTOM, 
-					std::get<0>(monitor.get_min_position()), std::get<1>(monitor.get_min_position()), 
-					std::get<0>(monitor.get_min_size()), std::get<1>(monitor.get_min_size()), 
-					SWP_SHOWWINDOW);
+	{
+		if (m_win32_saved_placement.length == sizeof(WINDOWPLACEMENT))
+		{
+			SetWindowLongPtr(m_handle, GWL_STYLE, m_win32_saved_style);
+			SetWindowPlacement(m_handle, &m_win32_saved_placement);
+			SetWindowPos(m_handle, nullptr, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_SHOWWINDOW | SWP_FRAMECHANGED);
+		} else {
+			const auto [width, height] = monitor.get_min_size();
+			SetWindowLongPtr(m_handle, GWL_STYLE, WS_OVERLAPPEDWINDOW);
+			SetWindowPos(m_handle, HWND_BOTTOM, static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height), SWP_SHOWWINDOW);
+		}
 		break;
 	}
+	}
+
+	m_display_mode = mode;
 }
 
 bool ndm::Display::has_focus() const
@@ -131,19 +465,61 @@ void ndm::Display::set_resizable_by_user(const bool resizable)
 				 SWP_SHOWWINDOW);
 }
 
-ndm::DisplayEvents ndm::Display::catch_events() noexcept
+void ndm::Display::set_sync_resize(const bool enabled)
 {
-	// Clear all events
-	std::memset(&m_events, 0, sizeof(ndm::DisplayEvents));
+	if(m_loaded == false)
+		throw std::exception("The display is not loaded !");
+
+	m_sync_resize.store(enabled, std::memory_order_release);
+
+	// A resize loop waiting for a frame stops waiting
+	if (enabled == false)
+		SetEvent(m_win32_resize_event);
+}
+
+void ndm::Display::acknowledge_resize() noexcept
+{
+	m_win32_presenting_thread.store(GetCurrentThreadId(), std::memory_order_relaxed);
+	if (m_resize_presented.load(std::memory_order_relaxed) == m_resize_seen)
+		return;
 
-	// While there are windows m_messages, we dipatch them
-	while (PeekMessage(&m_messages, m_handle, 0, 0, PM_REMOVE))
+	m_resize_presented.store(m_resize_seen, std::memory_order_release);
+	if (m_win32_resize_event != nullptr && m_sync_resize.load(std::memory_order_acquire) == true)
+		SetEvent(m_win32_resize_event);
+}
+
+void ndm::Display::pump_events(const std::chrono::milliseconds timeout) noexcept
+{
+	if (timeout.count() != 0 && m_loaded == true && m_closed == false)
+	{
+		// Sleep until a message is available, the wake event is signaled or the timeout expires
+		const DWORD milliseconds = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+		MsgWaitForMultipleObjectsEx(1, &m_wake_event, milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+	}
+
+	// The raw inputs waiting in the queue are read in a single call before the other messages
+	win32_read_raw_input_buffer(m_win32_raw_input_buffer, m_events);
+
+	// Dispatch all the messages of the thread, MsgWaitForMultipleObjectsEx returns while any of them is queued : the messages
+	// of this window, of the other windows of the thread (dispatched to the ring of their display) and the thread messages
+	while (PeekMessage(&m_messages, nullptr, 0, 0, PM_REMOVE))
 	{
 		TranslateMessage(&m_messages);
 		DispatchMessage(&m_messages);
 	}
+}
+
+void ndm::Display::wake() noexcept
+{
+	if (m_wake_event != nullptr)
+		SetEvent(m_wake_event);
+}
 
-	return m_events;
+void ndm::Display::release_wake_handle() noexcept
+{
+	if (m_wake_event != nullptr)
+		CloseHandle(m_wake_event);
+	m_wake_event = nullptr;
 }
 
 void ndm::Display::unload()
@@ -154,8 +530,19 @@ void ndm::Display::unload()
 	if(m_handle == nullptr)
 		throw std::exception("There is no handle !");
 
-	if(m_events.closed == false)
+	// The desktop never stays in the mode of the application
+	restore_exclusive_mode();
+	m_display_mode = ndm::DisplayMode::WINDOWED;
+
+	if(m_closed == false)
 		DestroyWindow(m_handle);
+
+	if (m_keep_wake_handle == false)
+		release_wake_handle();
+
+	CloseHandle(m_win32_resize_event);
+	m_win32_resize_event = nullptr;
+	m_sync_resize.store(false, std::memory_order_relaxed);
 		
 	m_loaded = false;
 }
@@ -183,6 +570,16 @@ void ndm::Display::set_visible(const bool visible)
 	}
 }
 
+void ndm::Display::set_geometry(const std::int64_t x, const std::int64_t y, const std::uint64_t width, const std::uint64_t height)
+{
+	if(m_loaded == false)
+		throw std::exception("The display is not loaded !");
+
+	if (SetWindowPos(m_handle, nullptr, static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height), 
+					 SWP_NOREDRAW | SWP_NOSENDCHANGING | SWP_NOZORDER | SWP_NOACTIVATE) == FALSE)
+		throw std::exception("Can't set the geometry of the window !");
+}
+
 void ndm::Display::set_x(const std::uint64_t x)
 {
 	if(m_loaded == false)
@@ -222,54 +619,6 @@ void ndm::Display::set_height(const std::uint64_t height)
 		throw std::exception("Can't set the height of the window !");
 }
 
-std::int64_t ndm::Display::get_x() const
-{
-	if (m_loaded == false)
-		return -1l;
-
-	RECT rect = { 0, 0, 0, 0 };
-	if (GetWindowRect(m_handle, &rect) == FALSE)
-		return -1l;
-
-	return rect.left;
-}
-
-std::int64_t ndm::Display::get_y() const
-{
-	if (m_loaded == false)
-		return -1;
-
-	RECT rect = { 0, 0, 0, 0 };
-	if (GetWindowRect(m_handle, &rect) == FALSE)
-		return -1;
-
-	return rect.bottom;
-}
-
-std::int64_t ndm::Display::get_width() const
-{
-	if (m_loaded == false)
-		return -1;
-
-	RECT rect = { 0, 0, 0, 0 };
-	if (GetWindowRect(m_handle, &rect) == FALSE)
-		return -1;
-
-	return rect.right - rect.left;
-}
-
-std::int64_t ndm::Display::get_height() const
-{
-	if (m_loaded == false)
-		return -1;
-
-	RECT rect = { 0, 0, 0, 0 };
-	if (GetWindowRect(m_handle, &rect) == FALSE)
-		return -1;
-
-	return rect.bottom - rect.top;
-}
-
 HWND & ndm::Display::get_win32_handle()
 {
 	return m_handle;
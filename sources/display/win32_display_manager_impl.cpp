@@ -0,0 +1,78 @@
+// Only compile on Windows (x32 or x64)
+#if defined(_WIN32) || defined(_WIN64)
+
+// NDM includes
+#include <ndm/display/display_manager.hpp>
+
+void ndm::DisplayManager::load()
+{
+	if (m_loaded == true)
+		throw std::exception("The display manager is already loaded !");
+
+	// Create the auto-reset event used by other threads to wake up wait_events()
+	m_wake_event = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+	if (m_wake_event == nullptr)
+		throw std::exception("Can't create the wake event !");
+
+	std::memset(&m_messages, 0, sizeof(MSG));
+	m_loaded = true;
+}
+
+void ndm::DisplayManager::unload()
+{
+	if (m_loaded == false)
+		throw std::exception("The display manager is not loaded !");
+
+	CloseHandle(m_wake_event);
+	m_wake_event = nullptr;
+
+	m_loaded = false;
+}
+
+const std::vector<ndm::DisplayManagerEvent> & ndm::DisplayManager::catch_events() noexcept
+{
+	NDM_TRACE_SCOPE("DisplayManager::catch_events");
+
+	// Consume the events of the previous call
+	clear_events();
+
+	// A single loop reads the messages of every window of the thread and the thread messages, the window procedure
+	// pushes the events in the ring of their display
+	while (PeekMessage(&m_messages, nullptr, 0, 0, PM_REMOVE))
+	{
+		TranslateMessage(&m_messages);
+		DispatchMessage(&m_messages);
+	}
+
+	collect_events();
+	return m_events;
+}
+
+const std::vector<ndm::DisplayManagerEvent> & ndm::DisplayManager::wait_events(const std::chrono::milliseconds timeout) noexcept
+{
+	NDM_TRACE_SCOPE("DisplayManager::wait_events");
+
+	if (m_loaded == true)
+	{
+		// The wake events of the displays also wake up the manager, a wait is limited to MAXIMUM_WAIT_OBJECTS handles
+		m_wait_handles.clear();
+		m_wait_handles.push_back(m_wake_event);
+		for (ndm::Display * display : m_displays)
+			if (display->m_wake_event != nullptr && m_wait_handles.size() < MAXIMUM_WAIT_OBJECTS - 1)
+				m_wait_handles.push_back(display->m_wake_event);
+
+		// Sleep until a message is available for any window of the thread, a wake event is signaled or the timeout expires
+		const DWORD milliseconds = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+		MsgWaitForMultipleObjectsEx(static_cast<DWORD>(m_wait_handles.size()), m_wait_handles.data(), milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+	}
+
+	return catch_events();
+}
+
+void ndm::DisplayManager::wake() noexcept
+{
+	if (m_wake_event != nullptr)
+		SetEvent(m_wake_event);
+}
+
+#endif
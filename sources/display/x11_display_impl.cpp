@@ -1,58 +1,948 @@
-// Only compile on Linux
-#if defined(__linux__)
+// Only compile on Linux, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
 
-#include <ndm/m_display.hpp>
+// STD includes
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
 
-namespace ndm
+// Linux includes
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// X11 includes
+#include <X11/Xresource.h>
+#include <X11/extensions/XInput2.h>
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/os/xrandr_functions.hpp>
+
+// Read the size of the decorations added by the window manager (left, right, top, bottom)
+static void x11_read_frame_extents(::Display * display, Window window, Atom net_frame_extents, long extents[4])
+{
+	Atom type = None;
+	int format = 0;
+	unsigned long count = 0;
+	unsigned long remaining = 0;
+	unsigned char * data = nullptr;
+	if (XGetWindowProperty(display, window, net_frame_extents, 0, 4, False, XA_CARDINAL,
+						   &type, &format, &count, &remaining, &data) == Success && count == 4)
+	{
+		const long * values = reinterpret_cast<const long *>(data);
+		for (int i = 0; i < 4; i++)
+			extents[i] = values[i];
+	}
+
+	if (data != nullptr)
+		XFree(data);
+}
+
+// Push a button of the mouse, the buttons 4 to 7 of X11 are the notches of the wheels and the buttons 8 and 9 are the extra buttons
+static void x11_push_mouse_button(ndm::DisplayEvents & events, const XButtonEvent & button_event, const bool pressed)
+{
+	const ndm::DisplayEventType type = pressed == true ? ndm::DisplayEventType::MOUSE_BUTTON_PRESSED : ndm::DisplayEventType::MOUSE_BUTTON_RELEASED;
+	switch (button_event.button)
+	{
+		case Button1:
+		case Button2:
+		case Button3:
+			events.push(type, button_event.x, button_event.y, 0, 0, 0, button_event.button);
+			break;
+		case Button4:
+		case Button5:
+			if (pressed == true)
+				events.push(ndm::DisplayEventType::MOUSE_WHEEL, 0, button_event.button == Button4 ? ndm::MOUSE_WHEEL_STEP : -ndm::MOUSE_WHEEL_STEP);
+			break;
+		case 6:
+		case 7:
+			if (pressed == true)
+				events.push(ndm::DisplayEventType::MOUSE_WHEEL, button_event.button == 6 ? -ndm::MOUSE_WHEEL_STEP : ndm::MOUSE_WHEEL_STEP, 0);
+			break;
+		case 8:
+		case 9:
+			events.push(type, button_event.x, button_event.y, 0, 0, 0, button_event.button - 4);
+			break;
+	}
+}
+
+// Push the relative motion of a raw event of XInput2, the valuators 0 and 1 are the axes of the mouse
+static void x11_push_raw_motion(ndm::DisplayEvents & events, const XIRawEvent & raw_event)
+{
+	double motion[2] = { 0.0, 0.0 };
+	const double * values = raw_event.raw_values;
+	for (int i = 0; i < raw_event.valuators.mask_len * 8; i++)
+	{
+		if (XIMaskIsSet(raw_event.valuators.mask, i) == 0)
+			continue;
+
+		if (i < 2)
+			motion[i] = *values;
+		values++;
+	}
+
+	if (motion[0] != 0.0 || motion[1] != 0.0)
+		events.push(ndm::DisplayEventType::MOUSE_RAW_MOTION, std::llround(motion[0]), std::llround(motion[1]));
+}
+
+// Read the Xft.dpi resource set by the desktop in the RESOURCE_MANAGER property of the root window, 0 if it isn't set. The
+// property is read again because XResourceManagerString() only keeps its value at the opening of the connection
+static std::uint32_t x11_read_xft_dpi(::Display * display, const Window root, const Atom resource_manager)
+{
+	Atom type = None;
+	int format = 0;
+	unsigned long count = 0;
+	unsigned long remaining = 0;
+	unsigned char * data = nullptr;
+	if (XGetWindowProperty(display, root, resource_manager, 0, 1 << 20, False, XA_STRING,
+						   &type, &format, &count, &remaining, &data) != Success)
+		return 0;
+
+	double dpi = 0.0;
+	if (data != nullptr && type == XA_STRING && format == 8)
+	{
+		XrmInitialize();
+		XrmDatabase database = XrmGetStringDatabase(reinterpret_cast<const char *>(data));
+		if (database != nullptr)
+		{
+			char * value_type = nullptr;
+			XrmValue value = {};
+			if (XrmGetResource(database, "Xft.dpi", "Xft.Dpi", &value_type, &value) == True && value.addr != nullptr)
+				dpi = std::strtod(value.addr, nullptr);
+			XrmDestroyDatabase(database);
+		}
+	}
+
+	if (data != nullptr)
+		XFree(data);
+
+	return dpi > 0.0 ? static_cast<std::uint32_t>(std::lround(dpi)) : 0;
+}
+
+// Read the area of the monitors with the DPI derived from their physical size
+static void x11_read_monitor_dpis(::Display * display, Window root, std::vector<ndm::X11MonitorDpi> & monitor_dpis)
+{
+	monitor_dpis.clear();
+
+	int monitor_count = 0;
+	XRRMonitorInfo * monitor_infos = XRRGetMonitors(display, root, True, &monitor_count);
+	for (int i = 0; i < monitor_count; i++)
+	{
+		const XRRMonitorInfo & monitor_info = monitor_infos[i];
+		monitor_dpis.push_back({ monitor_info.x, monitor_info.y, monitor_info.width, monitor_info.height, 
+								 ndm::x11_get_monitor_dpi(monitor_info, ndm::DEFAULT_DPI) });
+	}
+
+	if (monitor_infos != nullptr)
+		XRRFreeMonitors(monitor_infos);
+}
+
+void ndm::x11_process_events(ndm::Display * display, const XEvent & event)
+{
+	NDM_TRACE_SCOPE("x11_process_events");
+
+	if (display == nullptr)
+		return;
+
+	// The raw motion of XInput2 is sent to the root window, it is only reported while the display has the focus
+	if (event.type == GenericEvent && event.xcookie.extension == display->m_xi_opcode)
+	{
+		XGenericEventCookie cookie = event.xcookie;
+		if (display->m_x11_focused == true && cookie.evtype == XI_RawMotion && XGetEventData(display->m_display, &cookie) == True)
+		{
+			x11_push_raw_motion(display->get_events(), *static_cast<const XIRawEvent *>(cookie.data));
+			XFreeEventData(display->m_display, &cookie);
+		}
+		return;
+	}
+
+	// The desktop changes its scale with the Xft.dpi resource, the resources are a property of the root window
+	const Window root = RootWindow(display->m_display, display->m_screen);
+	if (event.type == PropertyNotify && event.xproperty.atom == display->m_x11_resource_manager && event.xproperty.window == root)
+	{
+		display->m_x11_xft_dpi = x11_read_xft_dpi(display->m_display, root, display->m_x11_resource_manager);
+		display->update_x11_dpi(true);
+		return;
+	}
+
+	if (event.xany.window != display->m_window)
+		return;
+
+	// A software framebuffer presented with MIT-SHM can reuse its image once the server has read it, the type of the 
+	// completion event is only known when a framebuffer queries the extension
+	if (event.type == display->m_shm_completion_type.load(std::memory_order_relaxed))
+	{
+		display->m_shm_completions.fetch_add(1, std::memory_order_release);
+		display->m_shm_completions.notify_all();
+		return;
+	}
+
+	ndm::DisplayEvents & events = display->get_events();
+
+	// A change of the monitors is reported once per call to catch_events(), the server sends a burst of events for a single change
+	if (display->m_randr_event_base >= 0 && (event.type == display->m_randr_event_base + RRScreenChangeNotify || event.type == display->m_randr_event_base + RRNotify))
+	{
+		XRRUpdateConfiguration(const_cast<XEvent *>(&event));
+		if (events.contains(ndm::DisplayEventType::MONITORS_CHANGED) == false)
+		{
+			events.push(ndm::DisplayEventType::MONITORS_CHANGED);
+			x11_read_monitor_dpis(display->m_display, RootWindow(display->m_display, display->m_screen), display->m_x11_monitor_dpis);
+			display->update_x11_dpi(true);
+		}
+		return;
+	}
+
+	switch (event.type)
+	{
+		case ClientMessage:
+		{
+			if (event.xclient.message_type != display->m_wm_protocols)
+				break;
+
+			const Atom protocol = static_cast<Atom>(event.xclient.data.l[0]);
+			if (protocol == display->m_wm_delete_window)
+				events.push(ndm::DisplayEventType::CLOSED);
+
+			// The window manager waits until the counter has the value of the request, the frame with the size of the next 
+			// configure event acknowledges it
+			if (protocol == display->m_net_wm_sync_request && display->m_x11_sync_counter != None)
+			{
+				const std::uint64_t low = static_cast<std::uint32_t>(event.xclient.data.l[2]);
+				const std::uint64_t high = static_cast<std::uint32_t>(event.xclient.data.l[3]);
+				display->m_x11_sync_value.store(static_cast<std::int64_t>((high << 32) | low), std::memory_order_relaxed);
+				display->m_x11_sync_pending = true;
+			}
+			break;
+		}
+		case ConfigureNotify:
+		{
+			ndm::DisplayGeometry & geometry = display->m_geometry;
+			ndm::DisplayGeometry & configured = display->m_x11_configured_geometry;
+
+			// A synthetic configure event is relative to the root window, a real one is relative to the parent window : the
+			// root window, or the frame of the window manager that also sends a synthetic event when the window moves
+			std::int64_t client_x = configured.x;
+			std::int64_t client_y = configured.y;
+			if (event.xconfigure.send_event == True || display->m_x11_reparented == false)
+			{
+				client_x = event.xconfigure.x;
+				client_y = event.xconfigure.y;
+			}
+
+			// The events are compared with the last confirmed geometry, set_geometry() already changed the cache
+			const std::int64_t x = client_x - display->m_frame_extents[0];
+			const std::int64_t y = client_y - display->m_frame_extents[2];
+			const bool resized = event.xconfigure.width != configured.client_width || event.xconfigure.height != configured.client_height;
+			if (resized == true)
+				events.push(ndm::DisplayEventType::RESIZED, 0, 0, event.xconfigure.width, event.xconfigure.height);
+			if (client_x != configured.x || client_y != configured.y)
+				events.push(ndm::DisplayEventType::MOVED, x, y);
+			configured.x = client_x;
+			configured.y = client_y;
+			configured.client_width = event.xconfigure.width;
+			configured.client_height = event.xconfigure.height;
+
+			// A configure event that follows a sync request is acknowledged by the next frame, even without a new size
+			if (resized == true || display->m_x11_sync_pending == true)
+			{
+				const std::uint64_t resize = display->m_resize_count.fetch_add(1, std::memory_order_release) + 1;
+				if (display->m_x11_sync_pending == true)
+					display->m_x11_sync_serial.store(resize, std::memory_order_release);
+				display->m_x11_sync_pending = false;
+			}
+
+			geometry.x = x;
+			geometry.y = y;
+			geometry.client_width = event.xconfigure.width;
+			geometry.client_height = event.xconfigure.height;
+			geometry.width = geometry.client_width + display->m_frame_extents[0] + display->m_frame_extents[1];
+			geometry.height = geometry.client_height + display->m_frame_extents[2] + display->m_frame_extents[3];
+
+			// The window may have moved to a monitor with another scale
+			display->update_x11_dpi(true);
+			break;
+		}
+		case ReparentNotify:
+		{
+			// The position in the frame of the window manager is not the position on the screen, it is read once here
+			// instead of on each configure event
+			display->m_x11_reparented = event.xreparent.parent != RootWindow(display->m_display, display->m_screen);
+			if (display->m_x11_reparented == true)
+			{
+				int client_x = 0;
+				int client_y = 0;
+				Window child = 0;
+				XTranslateCoordinates(display->m_display, display->m_window, RootWindow(display->m_display, display->m_screen), 0, 0, &client_x, &client_y, &child);
+				display->m_x11_configured_geometry.x = client_x;
+				display->m_x11_configured_geometry.y = client_y;
+			}
+
+			// The outer position of the frame is reported like the moves of the configure events
+			const std::int64_t x = display->m_x11_configured_geometry.x - display->m_frame_extents[0];
+			const std::int64_t y = display->m_x11_configured_geometry.y - display->m_frame_extents[2];
+			if (x != display->m_geometry.x || y != display->m_geometry.y)
+				events.push(ndm::DisplayEventType::MOVED, x, y);
+			display->m_geometry.x = x;
+			display->m_geometry.y = y;
+			break;
+		}
+		case PropertyNotify:
+		{
+			if (event.xproperty.atom == display->m_net_frame_extents)
+			{
+				x11_read_frame_extents(display->m_display, display->m_window, display->m_net_frame_extents, display->m_frame_extents);
+				ndm::DisplayGeometry & geometry = display->m_geometry;
+				geometry.width = geometry.client_width + display->m_frame_extents[0] + display->m_frame_extents[1];
+				geometry.height = geometry.client_height + display->m_frame_extents[2] + display->m_frame_extents[3];
+
+				// The client area stays in place, the outer position follows the new extents
+				const std::int64_t x = display->m_x11_configured_geometry.x - display->m_frame_extents[0];
+				const std::int64_t y = display->m_x11_configured_geometry.y - display->m_frame_extents[2];
+				if (x != geometry.x || y != geometry.y)
+					events.push(ndm::DisplayEventType::MOVED, x, y);
+				geometry.x = x;
+				geometry.y = y;
+				break;
+			}
+
+			if (event.xproperty.atom != display->m_net_wm_state)
+				break;
+
+			// Read the EWMH state of the window to know if it has been minimized or maximized
+			Atom type = None;
+			int format = 0;
+			unsigned long count = 0;
+			unsigned long remaining = 0;
+			unsigned char * data = nullptr;
+			if (XGetWindowProperty(display->m_display, display->m_window, display->m_net_wm_state, 0, 1024, False, XA_ATOM,
+								   &type, &format, &count, &remaining, &data) != Success)
+				break;
+
+			bool hidden = false;
+			bool maximized_vert = false;
+			bool maximized_horz = false;
+			const Atom * states = reinterpret_cast<const Atom *>(data);
+			for (unsigned long i = 0; i < count; i++)
+			{
+				if (states[i] == display->m_net_wm_state_hidden) hidden = true;
+				if (states[i] == display->m_net_wm_state_maximized_vert) maximized_vert = true;
+				if (states[i] == display->m_net_wm_state_maximized_horz) maximized_horz = true;
+			}
+
+			if (data != nullptr)
+				XFree(data);
+
+			if (hidden == true && display->m_minimized == false) 
+				events.push(ndm::DisplayEventType::MINIMIZED, 0, 0, display->m_geometry.client_width, display->m_geometry.client_height);
+			if (maximized_vert == true && maximized_horz == true && display->m_maximized == false) 
+				events.push(ndm::DisplayEventType::MAXIMIZED, 0, 0, display->m_geometry.client_width, display->m_geometry.client_height);
+			display->m_minimized = hidden;
+			display->m_maximized = maximized_vert && maximized_horz;
+			break;
+		}
+		case FocusIn:
+		case FocusOut:
+		{
+			// The focus moved by a grab or inside the window is ignored
+			if (event.xfocus.mode != NotifyNormal || event.xfocus.detail == NotifyInferior)
+				break;
+
+			// The keys and the buttons held are released by the input state, their releases are sent to the other window
+			if (display->m_x11_focused != (event.type == FocusIn))
+				events.push(event.type == FocusIn ? ndm::DisplayEventType::FOCUS_GAINED : ndm::DisplayEventType::FOCUS_LOST);
+			display->m_x11_focused = event.type == FocusIn;
+
+			// The exclusive mode is only kept while the display has the focus, alt-tab shows the desktop in its own mode
+			if (display->m_display_mode != ndm::DisplayMode::EXCLUSIVE_FULLSCREEN)
+				break;
+
+			if (event.type == FocusOut)
+				display->restore_exclusive_mode();
+			else if (display->m_x11_mode_changed == false)
+				display->apply_exclusive_mode();
+			break;
+		}
+		case KeyPress:
+		case KeyRelease:
+		{
+			// The key code is the scan code of the server (the evdev code + 8), the symbol is read without modifier
+			XKeyEvent key_event = event.xkey;
+			const KeySym symbol = XLookupKeysym(&key_event, 0);
+			events.push(event.type == KeyPress ? ndm::DisplayEventType::KEY_PRESSED : ndm::DisplayEventType::KEY_RELEASED, 0, 0, 0, 0, 
+						event.xkey.keycode, static_cast<std::uint32_t>(symbol));
+			break;
+		}
+		case ButtonPress:
+		case ButtonRelease:
+			x11_push_mouse_button(events, event.xbutton, event.type == ButtonPress);
+			break;
+		case MotionNotify:
+			events.push(ndm::DisplayEventType::MOUSE_MOVED, event.xmotion.x, event.xmotion.y);
+			break;
+		case DestroyNotify:
+			display->m_closed = true;
+			events.push(ndm::DisplayEventType::CLOSED);
+			break;
+	}
+}
+
+void ndm::Display::load(const std::string_view title, const std::uint64_t width, const std::uint64_t height, const bool visible)
+{
+	// The connection can be used by the OpenGL contexts of other threads (shared and headless contexts)
+	XInitThreads();
+
+	// Open the X display
+	m_display = XOpenDisplay(nullptr);
+	if (m_display == nullptr)
+		throw std::runtime_error("Can't open the X display !");
+
+	// Get the default screen
+	m_screen = DefaultScreen(m_display);
+
+	// Get the black and white pixel compatible with the default screen
+	m_black_pixel = BlackPixel(m_display, m_screen);
+	m_white_pixel = WhitePixel(m_display, m_screen);
+
+	// Create the window
+	XSetWindowAttributes attributes = {};
+	std::memset(&attributes, 0, sizeof(XSetWindowAttributes));
+	attributes.background_pixel = m_white_pixel;
+	attributes.border_pixel = m_black_pixel;
+	attributes.event_mask = StructureNotifyMask | PropertyChangeMask | FocusChangeMask | ExposureMask | 
+							KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask;
+	m_window = XCreateWindow(m_display, RootWindow(m_display, m_screen),
+							 0, 0,
+							 static_cast<unsigned int>(width), static_cast<unsigned int>(height), 0,
+							 CopyFromParent, InputOutput, CopyFromParent,
+							 CWBackPixel | CWBorderPixel | CWEventMask, &attributes);
+	if (m_window == 0)
+	{
+		XCloseDisplay(m_display);
+		throw std::runtime_error("Can't create the window !");
+	}
+
+	// Create the event file descriptor used by other threads to wake up wait_events()
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wake_fd < 0)
+	{
+		XDestroyWindow(m_display, m_window);
+		XCloseDisplay(m_display);
+		throw std::runtime_error("Can't create the wake event !");
+	}
+
+	// Retrieve the atoms used to talk with the window manager
+	m_wm_protocols = XInternAtom(m_display, "WM_PROTOCOLS", False);
+	m_wm_delete_window = XInternAtom(m_display, "WM_DELETE_WINDOW", False);
+	m_net_wm_state = XInternAtom(m_display, "_NET_WM_STATE", False);
+	m_net_wm_state_hidden = XInternAtom(m_display, "_NET_WM_STATE_HIDDEN", False);
+	m_net_wm_state_maximized_vert = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
+	m_net_wm_state_maximized_horz = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
+	m_net_wm_state_fullscreen = XInternAtom(m_display, "_NET_WM_STATE_FULLSCREEN", False);
+	m_net_frame_extents = XInternAtom(m_display, "_NET_FRAME_EXTENTS", False);
+	m_net_wm_sync_request = XInternAtom(m_display, "_NET_WM_SYNC_REQUEST", False);
+	m_net_wm_sync_request_counter = XInternAtom(m_display, "_NET_WM_SYNC_REQUEST_COUNTER", False);
+	m_x11_resource_manager = XInternAtom(m_display, "RESOURCE_MANAGER", False);
+
+	// Ask the window manager to send a message instead of killing the connection when the window is closed
+	XSetWMProtocols(m_display, m_window, &m_wm_delete_window, 1);
+
+	// Ask XRandR to notify the changes of the monitors, so the application doesn't have to enumerate them periodically
+	int randr_error_base = 0;
+	if (XRRQueryExtension(m_display, &m_randr_event_base, &randr_error_base) == True)
+		XRRSelectInput(m_display, m_window, RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
+	else
+		m_randr_event_base = -1;
+
+	// Ask XInput2 for the raw motion of the mouse, the relative motion without acceleration is only sent to the root window
+	int xi_event_base = 0;
+	int xi_error_base = 0;
+	int xi_major = 2;
+	int xi_minor = 0;
+	if (XQueryExtension(m_display, "XInputExtension", &m_xi_opcode, &xi_event_base, &xi_error_base) == True && XIQueryVersion(m_display, &xi_major, &xi_minor) == Success)
+	{
+		unsigned char mask_bits[XIMaskLen(XI_RawMotion)] = {};
+		XISetMask(mask_bits, XI_RawMotion);
+		XIEventMask mask = { XIAllMasterDevices, static_cast<int>(sizeof(mask_bits)), mask_bits };
+		XISelectEvents(m_display, RootWindow(m_display, m_screen), &mask, 1);
+	} else {
+		m_xi_opcode = -1;
+	}
+
+	// Clear structs
+	m_events.clear();
+	std::memset(&m_x11_event, 0, sizeof(XEvent));
+	std::memset(m_frame_extents, 0, sizeof(m_frame_extents));
+	m_geometry.x = 0;
+	m_geometry.y = 0;
+	m_geometry.width = m_geometry.client_width = static_cast<std::int64_t>(width);
+	m_geometry.height = m_geometry.client_height = static_cast<std::int64_t>(height);
+	m_x11_configured_geometry = m_geometry;
+	m_x11_reparented = false;
+	m_closed = false;
+	m_minimized = false;
+	m_maximized = false;
+	m_x11_focused = false;
+
+	// Read the scale of the content, the changes of the resources are notified on the root window. The events selected on
+	// the root window are kept, the property changes are added to them
+	const Window root = RootWindow(m_display, m_screen);
+	XWindowAttributes root_attributes = {};
+	const long root_event_mask = XGetWindowAttributes(m_display, root, &root_attributes) != 0 ? root_attributes.your_event_mask : NoEventMask;
+	XSelectInput(m_display, root, root_event_mask | PropertyChangeMask);
+	m_x11_xft_dpi = x11_read_xft_dpi(m_display, root, m_x11_resource_manager);
+	x11_read_monitor_dpis(m_display, root, m_x11_monitor_dpis);
+	update_x11_dpi(false);
+
+	// The renderers created before the first call to catch_events() have the initial size
+	m_framebuffer_width = m_geometry.client_width;
+	m_framebuffer_height = m_geometry.client_height;
+
+	// Set loaded
+	m_loaded = true;
+
+	// Set title and visibility
+	set_visible(visible);
+	set_title(title);
+}
+
+bool ndm::Display::set_x11_crtc_mode(const XID mode) noexcept
+{
+	XRRScreenResources * resources = XRRGetScreenResourcesCurrent(m_display, RootWindow(m_display, m_screen));
+	if (resources == nullptr)
+		return false;
+
+	const Status status = XRRSetCrtcConfig(m_display, resources, m_x11_fullscreen_crtc, CurrentTime, m_x11_crtc_x, m_x11_crtc_y, mode, m_x11_crtc_rotation,
+										   m_x11_crtc_outputs.data(), static_cast<int>(m_x11_crtc_outputs.size()));
+	XRRFreeScreenResources(resources);
+
+	return status == RRSetConfigSuccess;
+}
+
+bool ndm::Display::apply_exclusive_mode() noexcept
+{
+	if (set_x11_crtc_mode(m_x11_fullscreen_mode) == false)
+		return false;
+
+	m_x11_mode_changed = true;
+	return true;
+}
+
+void ndm::Display::restore_exclusive_mode() noexcept
+{
+	if (m_x11_mode_changed == false)
+		return;
+
+	set_x11_crtc_mode(m_x11_saved_mode);
+	XFlush(m_display);
+	m_x11_mode_changed = false;
+}
+
+void ndm::Display::set_display_mode(ndm::DisplayMode mode, const ndm::Monitor & monitor, const ndm::MonitorCapabilities & capabilities)
 {
-    void m_display::Load(const std::string_view title, const int width, const int height, const bool visible = false)
-    {
-        // Open the X m_display
-        m_display = XOpenDisplay(nullptr);
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
 
-        // Get the default m_screen
-        m_screen = DefaultScreen(m_display);
+	// The geometry is saved when the window leaves the windowed mode, so it comes back at the same place
+	if (m_display_mode == ndm::DisplayMode::WINDOWED && mode != ndm::DisplayMode::WINDOWED)
+		m_x11_saved_geometry = m_geometry;
 
-        // Get the black and white pixel compatible with the default m_screen
-        m_black_pixel = BlackPixel(m_display, m_screen);
-        m_white_pixel = WhitePixel(m_display, m_screen);
-        
-        // Create the window
-        m_window = XCreateSimpleWindow(m_display, 
-                                        DefaultRootWindow(m_display),
-                                        0, 0,
-                                        width, height, 1,
-                                        m_black_pixel, 
-                                        m_white_pixel);
+	// The mode of the desktop is restored before leaving the exclusive mode or changing its monitor, the CRTC is only known
+	// once the output of the new monitor is read
+	if (m_x11_mode_changed == true && mode != ndm::DisplayMode::EXCLUSIVE_FULLSCREEN)
+		restore_exclusive_mode();
 
-        // Set the m_window visible or not                                           
-        if(visible == true)
-            XMapWindow(m_display, m_window);
+	if (mode == ndm::DisplayMode::EXCLUSIVE_FULLSCREEN)
+	{
+		if (m_randr_event_base < 0)
+			throw std::runtime_error("The X server doesn't support XRandR !");
 
-        m_loaded = true;
-    }
+		XRRScreenResources * resources = XRRGetScreenResourcesCurrent(m_display, RootWindow(m_display, m_screen));
+		if (resources == nullptr)
+			throw std::runtime_error("Can't retrieve the screen resources with XRandR !");
 
-    DisplayEvents & m_display::CatchEvents() noexcept
-    {
-        // Get all the events
-        XNextEvent(m_display, &m_events);
+		XRROutputInfo * output_info = monitor.get_x11_output() != 0 ? XRRGetOutputInfo(m_display, resources, monitor.get_x11_output()) : nullptr;
+		if (output_info == nullptr || output_info->crtc == 0)
+		{
+			if (output_info != nullptr)
+				XRRFreeOutputInfo(output_info);
+			XRRFreeScreenResources(resources);
+			throw std::runtime_error("The monitor is not active !");
+		}
 
-        return m_events;
-    }
+		// Find the mode of the output with the requested size and the closest refresh rate
+		RRMode mode_id = 0;
+		std::uint32_t best_distance = 0;
+		for (int i = 0; i < output_info->nmode; i++)
+		{
+			for (int j = 0; j < resources->nmode; j++)
+			{
+				const XRRModeInfo & mode_info = resources->modes[j];
+				if (mode_info.id != output_info->modes[i] || mode_info.width != capabilities.m_width || mode_info.height != capabilities.m_height)
+					continue;
 
-    void m_display::Unload()
-    {
-		if (m_loaded == false)
-			throw std::runtime_error("Can't unload a m_window that is already unloaded !");
+				const std::uint32_t refresh_rate = ndm::x11_get_refresh_rate(mode_info);
+				const std::uint32_t distance = refresh_rate > capabilities.refresh_rate ? refresh_rate - static_cast<std::uint32_t>(capabilities.refresh_rate) : 
+											   static_cast<std::uint32_t>(capabilities.refresh_rate) - refresh_rate;
+				if (mode_id == 0 || distance < best_distance)
+				{
+					mode_id = mode_info.id;
+					best_distance = distance;
+				}
+			}
+		}
 
-        // Destroy the m_window
-        XDestroyWindow(m_display, m_window);
+		const RRCrtc crtc = output_info->crtc;
+		XRRFreeOutputInfo(output_info);
+		if (mode_id == 0)
+		{
+			XRRFreeScreenResources(resources);
+			throw std::runtime_error("The mode is not supported by the monitor !");
+		}
 
-        // Close the X m_display
-        XCloseDisplay(m_display);
+		// Another monitor is restored before its CRTC is forgotten
+		if (m_x11_mode_changed == true && m_x11_fullscreen_crtc != crtc)
+			restore_exclusive_mode();
 
-        m_loaded = false;
-    }
-};
+		// The mode of the desktop is only saved when it is not already changed
+		if (m_x11_mode_changed == false)
+		{
+			XRRCrtcInfo * crtc_info = XRRGetCrtcInfo(m_display, resources, crtc);
+			if (crtc_info == nullptr)
+			{
+				XRRFreeScreenResources(resources);
+				throw std::runtime_error("Can't retrieve the CRTC of the monitor !");
+			}
+
+			m_x11_fullscreen_crtc = crtc;
+			m_x11_saved_mode = crtc_info->mode;
+			m_x11_crtc_rotation = crtc_info->rotation;
+			m_x11_crtc_x = crtc_info->x;
+			m_x11_crtc_y = crtc_info->y;
+			m_x11_crtc_outputs.assign(crtc_info->outputs, crtc_info->outputs + crtc_info->noutput);
+			XRRFreeCrtcInfo(crtc_info);
+		}
+		XRRFreeScreenResources(resources);
+
+		m_x11_fullscreen_mode = mode_id;
+		if (apply_exclusive_mode() == false)
+			throw std::runtime_error("Can't change the mode of the monitor !");
+
+		// The window manager covers the monitor the window is on
+		XMoveWindow(m_display, m_window, m_x11_crtc_x, m_x11_crtc_y);
+	} else if (mode == ndm::DisplayMode::FULLSCREEN) {
+		// The window manager covers the monitor the window is on, in its current mode
+		const auto [x, y] = monitor.get_min_position();
+		XMoveWindow(m_display, m_window, static_cast<int>(x), static_cast<int>(y));
+	}
+
+	// Ask the window manager to add or remove the fullscreen state
+	XEvent event = {};
+	std::memset(&event, 0, sizeof(XEvent));
+	event.xclient.type = ClientMessage;
+	event.xclient.window = m_window;
+	event.xclient.message_type = m_net_wm_state;
+	event.xclient.format = 32;
+	event.xclient.data.l[0] = mode != ndm::DisplayMode::WINDOWED ? ndm::NET_WM_STATE_ADD : ndm::NET_WM_STATE_REMOVE;
+	event.xclient.data.l[1] = static_cast<long>(m_net_wm_state_fullscreen);
+	event.xclient.data.l[2] = 0;
+	event.xclient.data.l[3] = 1;
+
+	XSendEvent(m_display, RootWindow(m_display, m_screen), False, SubstructureRedirectMask | SubstructureNotifyMask, &event);
+
+	// The window manager restores the geometry of most windows, it is set again for the others
+	if (mode == ndm::DisplayMode::WINDOWED && m_display_mode != ndm::DisplayMode::WINDOWED)
+	{
+		const ndm::DisplayGeometry & geometry = m_x11_saved_geometry;
+		XMoveResizeWindow(m_display, m_window, static_cast<int>(geometry.x), static_cast<int>(geometry.y), 
+						  static_cast<unsigned int>(std::max<std::int64_t>(1, geometry.client_width)), static_cast<unsigned int>(std::max<std::int64_t>(1, geometry.client_height)));
+	}
+	XFlush(m_display);
+
+	m_display_mode = mode;
+}
+
+bool ndm::Display::has_focus() const
+{
+	if (m_loaded == false)
+		return false;
+
+	Window focused = 0;
+	int revert_to = 0;
+	XGetInputFocus(m_display, &focused, &revert_to);
+
+	return focused == m_window;
+}
+
+void ndm::Display::set_resizable_by_user(const bool resizable)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	XSizeHints * size_hints = XAllocSizeHints();
+	if (size_hints == nullptr)
+		throw std::runtime_error("Can't allocate the size hints !");
+
+	// A window that can't be resized has the same minimum and maximum size
+	if (resizable == false)
+	{
+		size_hints->flags = PMinSize | PMaxSize;
+		size_hints->min_width = size_hints->max_width = static_cast<int>(get_client_width());
+		size_hints->min_height = size_hints->max_height = static_cast<int>(get_client_height());
+	}
+
+	XSetWMNormalHints(m_display, m_window, size_hints);
+	XFree(size_hints);
+	XFlush(m_display);
+}
+
+void ndm::Display::update_x11_dpi(const bool notify) noexcept
+{
+	std::uint32_t dpi = m_x11_xft_dpi;
+	if (dpi == 0)
+	{
+		// The monitor under the center of the client area, the DPI is kept while the window is outside of the monitors
+		const std::int64_t center_x = m_geometry.x + m_frame_extents[0] + m_geometry.client_width / 2;
+		const std::int64_t center_y = m_geometry.y + m_frame_extents[2] + m_geometry.client_height / 2;
+		dpi = m_dpi;
+		for (const ndm::X11MonitorDpi & monitor : m_x11_monitor_dpis)
+		{
+			if (center_x >= monitor.x && center_x < monitor.x + monitor.width && center_y >= monitor.y && center_y < monitor.y + monitor.height)
+			{
+				dpi = monitor.dpi;
+				break;
+			}
+		}
+	}
+
+	if (dpi == m_dpi)
+		return;
+
+	m_dpi = dpi;
+	if (notify == true)
+		m_events.push(ndm::DisplayEventType::SCALE_CHANGED, m_dpi, 0, m_geometry.client_width, m_geometry.client_height);
+}
+
+void ndm::Display::pump_events(const std::chrono::milliseconds timeout) noexcept
+{
+	if (m_loaded == false || m_closed == true)
+		return;
+
+	// XPending flushes the requests and reads the events already sent by the server, we only sleep if there is none
+	if (timeout.count() != 0 && XPending(m_display) == 0)
+	{
+		pollfd fds[2] = {};
+		fds[0].fd = ConnectionNumber(m_display);
+		fds[0].events = POLLIN;
+		fds[1].fd = m_wake_fd;
+		fds[1].events = POLLIN;
+
+		const int milliseconds = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+		if (poll(fds, 2, milliseconds) > 0 && (fds[1].revents & POLLIN) != 0)
+		{
+			// Reset the counter of the wake event
+			eventfd_t value = 0;
+			eventfd_read(m_wake_fd, &value);
+		}
+	}
+
+	// While there are events already received, we process them without waiting for new ones
+	while (XPending(m_display) > 0)
+	{
+		XNextEvent(m_display, &m_x11_event);
+		ndm::x11_process_events(this, m_x11_event);
+	}
+}
+
+void ndm::Display::wake() noexcept
+{
+	if (m_wake_fd >= 0)
+		eventfd_write(m_wake_fd, 1);
+}
+
+void ndm::Display::set_sync_resize(const bool enabled)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (enabled == true && m_x11_sync_counter == None)
+	{
+		int sync_event_base = 0;
+		int sync_error_base = 0;
+		int sync_major = 0;
+		int sync_minor = 0;
+		if (XSyncQueryExtension(m_display, &sync_event_base, &sync_error_base) == False || XSyncInitialize(m_display, &sync_major, &sync_minor) == False)
+			throw std::runtime_error("The XSync extension is not available !");
+
+		// The counter is kept until the window is destroyed, the thread that presents the frames may still set it
+		XSyncValue value;
+		XSyncIntToValue(&value, 0);
+		m_x11_sync_counter = XSyncCreateCounter(m_display, value);
+		if (m_x11_sync_counter == None)
+			throw std::runtime_error("Can't create the sync counter of the window !");
+	}
+
+	// The window manager only sends the requests when the protocol and the counter are set on the window
+	if (enabled == true)
+	{
+		const long counter = static_cast<long>(m_x11_sync_counter);
+		XChangeProperty(m_display, m_window, m_net_wm_sync_request_counter, XA_CARDINAL, 32, PropModeReplace, reinterpret_cast<const unsigned char *>(&counter), 1);
+		Atom protocols[2] = { m_wm_delete_window, m_net_wm_sync_request };
+		XSetWMProtocols(m_display, m_window, protocols, 2);
+	} else {
+		XSetWMProtocols(m_display, m_window, &m_wm_delete_window, 1);
+		XDeleteProperty(m_display, m_window, m_net_wm_sync_request_counter);
+	}
+	XFlush(m_display);
+
+	m_sync_resize.store(enabled, std::memory_order_release);
+}
+
+void ndm::Display::acknowledge_resize() noexcept
+{
+	m_resize_presented.store(m_resize_seen, std::memory_order_release);
+	if (m_sync_resize.load(std::memory_order_acquire) == false)
+		return;
+
+	// The request is acknowledged once the configure event that followed it has been caught by the presenting thread
+	const std::uint64_t serial = m_x11_sync_serial.load(std::memory_order_acquire);
+	if (serial == 0 || serial == m_x11_sync_acknowledged || m_resize_seen < serial)
+		return;
+
+	const std::int64_t request = m_x11_sync_value.load(std::memory_order_relaxed);
+	XSyncValue value;
+	XSyncIntsToValue(&value, static_cast<unsigned int>(request & 0xFFFFFFFF), static_cast<int>(request >> 32));
+	XSyncSetCounter(m_display, m_x11_sync_counter, value);
+	XFlush(m_display);
+	m_x11_sync_acknowledged = serial;
+}
+
+void ndm::Display::unload()
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (m_display == nullptr)
+		throw std::runtime_error("There is no X display !");
+
+	// The desktop never stays in the mode of the application
+	restore_exclusive_mode();
+	m_display_mode = ndm::DisplayMode::WINDOWED;
+
+	// Destroy the window
+	if (m_closed == false)
+		XDestroyWindow(m_display, m_window);
+
+	if (m_x11_sync_counter != None)
+		XSyncDestroyCounter(m_display, m_x11_sync_counter);
+	m_x11_sync_counter = None;
+	m_x11_sync_pending = false;
+	m_x11_sync_serial.store(0, std::memory_order_relaxed);
+	m_x11_sync_acknowledged = 0;
+	m_sync_resize.store(false, std::memory_order_relaxed);
+
+	// Close the X display
+	XCloseDisplay(m_display);
+	m_display = nullptr;
+
+	if (m_keep_wake_handle == false)
+		release_wake_handle();
+
+	m_loaded = false;
+}
+
+void ndm::Display::release_wake_handle() noexcept
+{
+	if (m_wake_fd >= 0)
+		close(m_wake_fd);
+	m_wake_fd = -1;
+}
+
+void ndm::Display::set_title(const std::string_view title)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	std::string new_title = std::string(title);
+	if (XStoreName(m_display, m_window, new_title.c_str()) == 0)
+		throw std::runtime_error("Can't set the title of the window !");
+
+	// Set the UTF-8 title for EWMH window managers
+	XChangeProperty(m_display, m_window,
+					XInternAtom(m_display, "_NET_WM_NAME", False), XInternAtom(m_display, "UTF8_STRING", False),
+					8, PropModeReplace, reinterpret_cast<const unsigned char *>(new_title.c_str()), static_cast<int>(new_title.size()));
+	XFlush(m_display);
+}
+
+void ndm::Display::set_visible(const bool visible)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (visible == true)
+	{
+		XMapWindow(m_display, m_window);
+	} else {
+		XUnmapWindow(m_display, m_window);
+	}
+
+	XFlush(m_display);
+}
+
+void ndm::Display::set_geometry(const std::int64_t x, const std::int64_t y, const std::uint64_t width, const std::uint64_t height)
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	// The size given to X is the size of the client area, without the decorations of the window manager
+	const std::int64_t client_width = std::max<std::int64_t>(1, static_cast<std::int64_t>(width) - m_frame_extents[0] - m_frame_extents[1]);
+	const std::int64_t client_height = std::max<std::int64_t>(1, static_cast<std::int64_t>(height) - m_frame_extents[2] - m_frame_extents[3]);
+	XMoveResizeWindow(m_display, m_window, static_cast<int>(x), static_cast<int>(y), static_cast<unsigned int>(client_width), static_cast<unsigned int>(client_height));
+	XFlush(m_display);
+
+	// The configure event confirms the geometry later, the cache is updated now so the getters match the request. The event
+	// is compared with the last confirmed geometry, so it still reports RESIZED and MOVED
+	m_geometry.x = x;
+	m_geometry.y = y;
+	m_geometry.width = static_cast<std::int64_t>(width);
+	m_geometry.height = static_cast<std::int64_t>(height);
+	m_geometry.client_width = client_width;
+	m_geometry.client_height = client_height;
+}
+
+void ndm::Display::set_x(const std::uint64_t x)
+{
+	set_geometry(static_cast<std::int64_t>(x), get_y(), static_cast<std::uint64_t>(get_width()), static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_y(const std::uint64_t y)
+{
+	set_geometry(get_x(), static_cast<std::int64_t>(y), static_cast<std::uint64_t>(get_width()), static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_width(const std::uint64_t width)
+{
+	set_geometry(get_x(), get_y(), width, static_cast<std::uint64_t>(get_height()));
+}
+
+void ndm::Display::set_height(const std::uint64_t height)
+{
+	set_geometry(get_x(), get_y(), static_cast<std::uint64_t>(get_width()), height);
+}
+
+::Display * ndm::Display::get_x11_display() const
+{
+	return m_display;
+}
+
+Window ndm::Display::get_x11_window() const
+{
+	return m_window;
+}
+
+int ndm::Display::get_x11_screen() const
+{
+	return m_screen;
+}
 
-#endif
\ No newline at end of file
+#endif
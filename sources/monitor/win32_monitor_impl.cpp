@@ -3,11 +3,29 @@
 
 // NDM includes
 #include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_registry.hpp>
 
 std::vector<ndm::Monitor> ndm::Monitor::get_all_monitors()
 {
+    NDM_TRACE_SCOPE("Monitor::get_all_monitors");
+
+    // Enumerate the monitors once with a temporary registry
+    ndm::MonitorRegistry registry;
+    registry.refresh();
+
     // Instantiate the list of monitors
     std::vector<ndm::Monitor> monitors;
+    monitors.reserve(registry.get_handles().size());
+    for(const ndm::MonitorHandle handle : registry.get_handles())
+        monitors.push_back(registry.get_monitor(handle));
+
+    return monitors;
+}
+
+bool ndm::MonitorRegistry::refresh()
+{
+    begin_refresh();
+    bool changed = false;
 
     // Enumerate every monitors
     unsigned int monitor_index = 0;
@@ -18,141 +36,70 @@ std::vector<ndm::Monitor> ndm::Monitor::get_all_monitors()
     while(EnumDisplayDevicesA(nullptr, monitor_index++, &display_device, 0) > 0)
     {
         // If the device is an active monitor
-        if((display_device.StateFlags & DISPLAY_DEVICE_ACTIVE) == DISPLAY_DEVICE_ACTIVE)
-        {
-            // Fill monitor data
-            ndm::Monitor monitor;
-            monitor.m_display_index = monitor_index;
-            monitor.m_display_device = display_device;
-
-            // Enum every display mode of the monitor
-            unsigned int mode_index = 0;
-            DEVMODEA device_mode = {};
-            device_mode.dmSize = sizeof(DEVMODEA);
-            while(EnumDisplaySettingsA(display_device.DeviceName, mode_index++, &device_mode) > 0)
-            {
-                // Add the capabilities to the list
-                monitor.m_device_modes.push_back(device_mode);
-            }
-            
-            // Add the monitor in the list
-            monitors.push_back(monitor);
-        }
-    }
-
-    return monitors;
-}
+        if((display_device.StateFlags & DISPLAY_DEVICE_ACTIVE) != DISPLAY_DEVICE_ACTIVE)
+            continue;
 
-std::string ndm::Monitor::get_name() const
-{
-    return std::string(m_display_device.DeviceName);
-}
+        // The state is read with two cheap calls, the physical monitor plugged on the output and its current mode
+        MonitorState state;
+        state.flags = display_device.StateFlags;
 
-std::vector<ndm::MonitorCapabilities> ndm::Monitor::get_all_capabilities() const
-{
-    std::vector<ndm::MonitorCapabilities> monitor_capabilities;
+        DISPLAY_DEVICEA monitor_device = {};
+        monitor_device.cb = sizeof(DISPLAY_DEVICEA);
+        if(EnumDisplayDevicesA(display_device.DeviceName, 0, &monitor_device, 0) > 0)
+            state.id = monitor_device.DeviceID;
 
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        ndm::MonitorCapabilities capabilities = {};
-        std::memset(&monitor_capabilities, 0, sizeof(ndm::MonitorCapabilities));
-        capabilities.m_width = device_mode.dmPelsWidth;
-        capabilities.m_height = device_mode.dmPelsHeight;
-        capabilities.m_x = device_mode.dmPosition.x;
-        capabilities.m_y = device_mode.dmPosition.y;
-        capabilities.refresh_rate = device_mode.dmDisplayFrequency;
-    }
-
-    return monitor_capabilities;
-}
-
-std::tuple<unsigned long, unsigned long> ndm::Monitor::get_max_size() const
-{
-    unsigned long width = 0;
-    unsigned long height = 0;
-    unsigned long max_size = 0;
-
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        unsigned long current = device_mode.dmPelsWidth * device_mode.dmPelsHeight;
-
-        if(current > max_size)
+        DEVMODEA device_mode = {};
+        device_mode.dmSize = sizeof(DEVMODEA);
+        if(EnumDisplaySettingsA(display_device.DeviceName, ENUM_CURRENT_SETTINGS, &device_mode) > 0)
         {
-            width = device_mode.dmPelsWidth;
-            height = device_mode.dmPelsHeight;
-            max_size = current;
+            state.x = device_mode.dmPosition.x;
+            state.y = device_mode.dmPosition.y;
+            state.width = device_mode.dmPelsWidth;
+            state.height = device_mode.dmPelsHeight;
+            state.refresh_rate = device_mode.dmDisplayFrequency;
         }
-    }
 
-    return std::tuple<unsigned long, unsigned long>(width, height);
-}
-
-std::tuple<unsigned long, unsigned long> ndm::Monitor::get_min_size() const
-{
-    unsigned long width = 0;
-    unsigned long height = 0;
-    unsigned long min_size = ULONG_MAX;
-
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        unsigned long current = device_mode.dmPelsWidth * device_mode.dmPelsHeight;
+        bool inserted = false;
+        Slot & slot = find_slot(display_device.DeviceName, inserted);
+        slot.monitor.m_display_index = monitor_index;
+        if(inserted == false && slot.state == state)
+            continue;
 
-        if(current < min_size)
+        // Enum every display mode of the monitor only when it is new or replaced, the table sorts and deduplicates them 
+        // (a mode is listed for each color depth)
+        if(inserted == true || slot.state.id != state.id)
         {
-            width = device_mode.dmPelsWidth;
-            height = device_mode.dmPelsHeight;
-            min_size = current;
+            std::vector<ndm::MonitorMode> modes;
+            unsigned int mode_index = 0;
+            std::memset(&device_mode, 0, sizeof(DEVMODEA));
+            device_mode.dmSize = sizeof(DEVMODEA);
+            while(EnumDisplaySettingsA(display_device.DeviceName, mode_index++, &device_mode) > 0)
+            {
+                modes.push_back(ndm::MonitorMode { device_mode.dmPelsWidth, device_mode.dmPelsHeight, device_mode.dmDisplayFrequency });
+            }
+            slot.monitor.m_modes.build(std::move(modes));
         }
-    }
-
-    return std::tuple<unsigned long, unsigned long>(width, height);
-}
-
-std::tuple<unsigned long, unsigned long> ndm::Monitor::get_min_position() const
-{
-    unsigned long x = 0;
-    unsigned long y = 0;
-    unsigned long min_position = ULONG_MAX;
-
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        unsigned long current = device_mode.dmPosition.x + device_mode.dmPosition.y;
 
-        if(current < min_position)
-        {
-            x = device_mode.dmPosition.x;
-            y = device_mode.dmPosition.y;
-            min_position = current;
-        }
+        // Fill monitor data
+        slot.monitor.m_display_device = display_device;
+        slot.monitor.m_x = state.x;
+        slot.monitor.m_y = state.y;
+        slot.state = std::move(state);
+        changed = true;
     }
 
-    return std::tuple<unsigned long, unsigned long>(x, y);
-}
-
-unsigned long ndm::Monitor::get_max_refresh_rate() const
-{
-    unsigned long max_refresh_rate = 0;
+    if(release_unseen_slots() == true)
+        changed = true;
 
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        if(device_mode.dmDisplayFrequency > max_refresh_rate)
-            max_refresh_rate = device_mode.dmDisplayFrequency;
-    }
+    if(changed == true)
+        m_generation++;
 
-    return max_refresh_rate;
+    return changed;
 }
 
-unsigned long ndm::Monitor::get_min_refresh_rate() const
+std::string ndm::Monitor::get_name() const
 {
-    unsigned long max_refresh_rate = ULONG_MAX;
-
-    for(const DEVMODEA & device_mode : m_device_modes)
-    {
-        if(device_mode.dmDisplayFrequency < max_refresh_rate)
-            max_refresh_rate = device_mode.dmDisplayFrequency;
-    }
-
-    return max_refresh_rate;
+    return std::string(m_display_device.DeviceName);
 }
 
 bool ndm::Monitor::is_primary() const
@@ -165,11 +112,6 @@ const DISPLAY_DEVICEA & ndm::Monitor::get_win32_display_device() const
     return m_display_device;
 }
 
-const std::vector<DEVMODEA> & ndm::Monitor::get_win32_device_modes() const
-{
-    return m_device_modes;
-}
-
 unsigned long ndm::Monitor::get_win32_display_index() const
 {
     return m_display_index;
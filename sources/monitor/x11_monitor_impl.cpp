@@ -0,0 +1,168 @@
+// Only compile on Linux, the headless build has no monitor
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// STD includes
+#include <mutex>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+// NDM includes
+#include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_registry.hpp>
+#include <ndm/os/xrandr_functions.hpp>
+
+// The monitors are enumerated with a connection opened once for the whole process, so the enumeration doesn't need a display
+// and never reads the events of a display
+static std::once_flag x11_monitor_connection_opened;
+static ::Display * x11_monitor_connection = nullptr;
+
+static void x11_open_monitor_connection()
+{
+	XInitThreads();
+	x11_monitor_connection = XOpenDisplay(nullptr);
+}
+
+std::vector<ndm::Monitor> ndm::Monitor::get_all_monitors()
+{
+	NDM_TRACE_SCOPE("Monitor::get_all_monitors");
+
+	// Enumerate the monitors once with a temporary registry
+	ndm::MonitorRegistry registry;
+	registry.refresh();
+
+	// Instantiate the list of monitors
+	std::vector<ndm::Monitor> monitors;
+	monitors.reserve(registry.get_handles().size());
+	for (const ndm::MonitorHandle handle : registry.get_handles())
+		monitors.push_back(registry.get_monitor(handle));
+
+	return monitors;
+}
+
+bool ndm::MonitorRegistry::refresh()
+{
+	std::call_once(x11_monitor_connection_opened, x11_open_monitor_connection);
+	::Display * display = x11_monitor_connection;
+	if (display == nullptr)
+		throw std::runtime_error("Can't open the X display !");
+
+	int event_base = 0;
+	int error_base = 0;
+	int major = 0;
+	int minor = 0;
+	if (XRRQueryExtension(display, &event_base, &error_base) == False || XRRQueryVersion(display, &major, &minor) == 0 || major < 1 || (major == 1 && minor < 5))
+		throw std::runtime_error("The X server doesn't support XRandR 1.5 !");
+
+	// The current resources are the configuration known by the server, XRRGetScreenResources would probe the outputs 
+	// and stall for hundreds of milliseconds
+	const Window root = DefaultRootWindow(display);
+	XRRScreenResources * resources = XRRGetScreenResourcesCurrent(display, root);
+	if (resources == nullptr)
+		throw std::runtime_error("Can't retrieve the screen resources with XRandR !");
+
+	// The modes of the outputs can only change with the configuration of the screen
+	const bool configuration_changed = resources->configTimestamp != m_x11_config_timestamp;
+	m_x11_config_timestamp = resources->configTimestamp;
+
+	// Sort the modes of the screen by id once, so the modes of each output are found by binary search
+	std::vector<const XRRModeInfo *> screen_modes(static_cast<std::size_t>(resources->nmode));
+	for (int i = 0; i < resources->nmode; i++)
+		screen_modes[static_cast<std::size_t>(i)] = &resources->modes[i];
+	std::sort(screen_modes.begin(), screen_modes.end(), [](const XRRModeInfo * a, const XRRModeInfo * b) { return a->id < b->id; });
+
+	begin_refresh();
+	bool changed = false;
+
+	int monitor_count = 0;
+	XRRMonitorInfo * monitor_infos = XRRGetMonitors(display, root, True, &monitor_count);
+	for (int i = 0; i < monitor_count; i++)
+	{
+		const XRRMonitorInfo & monitor_info = monitor_infos[i];
+
+		MonitorState state;
+		state.id = std::to_string(monitor_info.noutput > 0 ? monitor_info.outputs[0] : 0);
+		state.x = monitor_info.x;
+		state.y = monitor_info.y;
+		state.width = monitor_info.width;
+		state.height = monitor_info.height;
+		state.flags = monitor_info.primary == True ? 1 : 0;
+
+		// The name of a monitor is an atom, its value identifies the monitor without a round trip
+		bool inserted = false;
+		Slot & slot = find_slot(std::to_string(monitor_info.name), inserted);
+		if (inserted == false && configuration_changed == false && slot.state == state)
+			continue;
+
+		ndm::Monitor & monitor = slot.monitor;
+		if (inserted == true)
+		{
+			char * name = XGetAtomName(display, monitor_info.name);
+			if (name != nullptr)
+			{
+				monitor.m_x11_name = name;
+				XFree(name);
+			}
+		}
+
+		// The modes of the monitor are the modes of its first output, they are only read again when the output or the 
+		// configuration changed, the table sorts and deduplicates them
+		if (inserted == true || configuration_changed == true || slot.state.id != state.id)
+		{
+			monitor.m_x11_output = monitor_info.noutput > 0 ? monitor_info.outputs[0] : 0;
+
+			std::vector<ndm::MonitorMode> modes;
+			XRROutputInfo * output_info = monitor.m_x11_output != 0 ? XRRGetOutputInfo(display, resources, monitor.m_x11_output) : nullptr;
+			if (output_info != nullptr)
+			{
+				modes.reserve(static_cast<std::size_t>(output_info->nmode));
+				for (int j = 0; j < output_info->nmode; j++)
+				{
+					const RRMode id = output_info->modes[j];
+					const auto found = std::lower_bound(screen_modes.begin(), screen_modes.end(), id, [](const XRRModeInfo * mode, const RRMode value) { return mode->id < value; });
+					if (found != screen_modes.end() && (*found)->id == id)
+						modes.push_back(ndm::MonitorMode { (*found)->width, (*found)->height, ndm::x11_get_refresh_rate(**found) });
+				}
+
+				XRRFreeOutputInfo(output_info);
+			}
+			monitor.m_modes.build(std::move(modes));
+		}
+
+		// Fill monitor data
+		monitor.m_x = state.x;
+		monitor.m_y = state.y;
+		monitor.m_x11_primary = monitor_info.primary == True;
+		slot.state = std::move(state);
+		changed = true;
+	}
+
+	if (monitor_infos != nullptr)
+		XRRFreeMonitors(monitor_infos);
+	XRRFreeScreenResources(resources);
+
+	if (release_unseen_slots() == true)
+		changed = true;
+
+	if (changed == true)
+		m_generation++;
+
+	return changed;
+}
+
+std::string ndm::Monitor::get_name() const
+{
+	return m_x11_name;
+}
+
+bool ndm::Monitor::is_primary() const
+{
+	return m_x11_primary;
+}
+
+XID ndm::Monitor::get_x11_output() const
+{
+	return m_x11_output;
+}
+
+#endif
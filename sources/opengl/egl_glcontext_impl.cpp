@@ -0,0 +1,332 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// STD includes
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+// NDM includes
+#include <ndm/opengl/gl_context.hpp>
+
+// GL includes
+#include <GL/gl.h>
+
+// Create a pbuffer of the given size, the size is clamped to 1 pixel because EGL refuses empty surfaces
+static EGLSurface egl_create_pbuffer(EGLDisplay display, EGLConfig config, const std::int64_t width, const std::int64_t height)
+{
+	const EGLint pbuffer_attributes[] =
+	{
+		EGL_WIDTH, static_cast<EGLint>(width > 1 ? width : 1),
+		EGL_HEIGHT, static_cast<EGLint>(height > 1 ? height : 1),
+		EGL_NONE
+	};
+
+	return eglCreatePbufferSurface(display, config, pbuffer_attributes);
+}
+
+// Set once the EGL functions are loaded
+static std::once_flag egl_functions_loaded;
+
+// The KHR and EXT versions of the swap with damage have the same signature and the same meaning
+static void egl_load_functions()
+{
+	ndm::eglSwapBuffersWithDamageKHR = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC) eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+	if (ndm::eglSwapBuffersWithDamageKHR == nullptr)
+		ndm::eglSwapBuffersWithDamageKHR = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC) eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+}
+
+void ndm::GLContext::load(const GLContextParams & params)
+{
+	NDM_TRACE_SCOPE("GLContext::load");
+
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::runtime_error("The OpenGL context is already loaded !");
+
+	if(eglGetCurrentContext() != EGL_NO_CONTEXT)
+		throw std::runtime_error("The current thread already has an OpenGL context !");
+
+	if(params.shared_context != nullptr && params.shared_context->m_loaded == false)
+		throw std::runtime_error("The shared OpenGL context is not loaded !");
+
+	// A context bound to a display uses its EGL display, a headless context uses the one of the context it shares its 
+	// objects with, or acquires the surfaceless display of the process otherwise
+	m_egl_owns_display = false;
+	if (m_display_ptr != nullptr)
+	{
+		m_egl_display = m_display_ptr->get_egl_display();
+	} else if (params.shared_context != nullptr) {
+		m_egl_display = params.shared_context->m_egl_display;
+	} else {
+		m_egl_display = ndm::egl_acquire_display();
+		m_egl_owns_display = true;
+	}
+
+	try {
+		if (eglBindAPI(EGL_OPENGL_API) == EGL_FALSE)
+			throw std::runtime_error("The EGL display doesn't support desktop OpenGL !");
+
+		// Choose a config that can render to a pbuffer, the pbuffers are single buffered so params.double_buffer is ignored
+		const EGLint color_component_bits = params.color_bits / 3;
+		const EGLint config_attributes[] =
+		{
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, color_component_bits,
+			EGL_GREEN_SIZE, color_component_bits,
+			EGL_BLUE_SIZE, color_component_bits,
+			EGL_ALPHA_SIZE, params.alpha_bits,
+			EGL_DEPTH_SIZE, params.depth_bits,
+			EGL_STENCIL_SIZE, params.stencil_bits,
+			EGL_SAMPLE_BUFFERS, params.samples_buffers,
+			EGL_SAMPLES, params.samples,
+			EGL_NONE
+		};
+
+		EGLint number_of_configs = 0;
+		if (eglChooseConfig(m_egl_display, config_attributes, &m_egl_config, 1, &number_of_configs) == EGL_FALSE || number_of_configs == 0)
+			throw std::runtime_error("Can't choose a config with EGL !");
+
+		// Set context attributes array
+		EGLint flags = 0;
+		if(params.debug_mode == true)
+			flags = flags | EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+
+		EGLint context_profile = EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR;
+		if(params.profile == ndm::GLContextProfile::COMPATIBILITY_PROFILE)
+			context_profile = EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR;
+
+		const EGLint context_attributes[] =
+		{
+			EGL_CONTEXT_MAJOR_VERSION_KHR, params.major_version,
+			EGL_CONTEXT_MINOR_VERSION_KHR, params.minor_version,
+			EGL_CONTEXT_FLAGS_KHR, flags,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, context_profile,
+			EGL_NONE
+		};
+
+		EGLContext shared_egl_context = params.shared_context != nullptr ? params.shared_context->m_egl_context : EGL_NO_CONTEXT;
+		m_egl_context = eglCreateContext(m_egl_display, m_egl_config, shared_egl_context, context_attributes);
+		if (m_egl_context == EGL_NO_CONTEXT)
+			throw std::runtime_error("Can't create an OpenGL context with EGL !");
+
+		// The pbuffer has the client size of the display, or a single pixel for a headless context
+		m_egl_surface_width = m_display_ptr != nullptr ? std::max<EGLint>(1, static_cast<EGLint>(m_display_ptr->get_framebuffer_width())) : 1;
+		m_egl_surface_height = m_display_ptr != nullptr ? std::max<EGLint>(1, static_cast<EGLint>(m_display_ptr->get_framebuffer_height())) : 1;
+		m_egl_surface = egl_create_pbuffer(m_egl_display, m_egl_config, m_egl_surface_width, m_egl_surface_height);
+		if (m_egl_surface == EGL_NO_SURFACE)
+		{
+			eglDestroyContext(m_egl_display, m_egl_context);
+			throw std::runtime_error("Can't create the pbuffer of the OpenGL context !");
+		}
+
+		// Make current thread an OpenGL context
+		if (eglMakeCurrent(m_egl_display, m_egl_surface, m_egl_surface, m_egl_context) == EGL_FALSE)
+		{
+			eglDestroySurface(m_egl_display, m_egl_surface);
+			eglDestroyContext(m_egl_display, m_egl_context);
+			throw std::runtime_error("Can't make the current thread an OpenGL context !");
+		}
+
+		// Load the EGL functions once for the whole process, the next contexts skip this step
+		std::call_once(egl_functions_loaded, egl_load_functions);
+		const char * extensions = eglQueryString(m_egl_display, EGL_EXTENSIONS);
+		m_egl_swap_buffers_with_damage = ndm::eglSwapBuffersWithDamageKHR != nullptr && 
+			(ndm::gl_has_extension(extensions, "EGL_KHR_swap_buffers_with_damage") == true || ndm::gl_has_extension(extensions, "EGL_EXT_swap_buffers_with_damage") == true);
+
+		// A pbuffer is never presented, so there is no swap interval and no refresh period to count missed intervals with
+		m_swap_control.swap_interval = false;
+		m_swap_control.immediate = false;
+		m_swap_control.adaptive = false;
+		m_swap_interval = 0;
+		m_frame_timer.set_swap_interval(0);
+		m_frame_timer.set_refresh_period(std::chrono::nanoseconds(0));
+		m_frame_timer.reset();
+	} catch (...) {
+		if (m_egl_owns_display == true)
+			ndm::egl_release_display();
+		m_egl_display = EGL_NO_DISPLAY;
+		throw;
+	}
+
+	m_loaded = true;
+}
+
+void ndm::GLContext::unload()
+{
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	// Make the current context null if it is this one
+	if(eglGetCurrentContext() == m_egl_context)
+		eglMakeCurrent(m_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+	// Delete the GL context and its pbuffer
+	eglDestroyContext(m_egl_display, m_egl_context);
+	m_egl_context = EGL_NO_CONTEXT;
+
+	eglDestroySurface(m_egl_display, m_egl_surface);
+	m_egl_surface = EGL_NO_SURFACE;
+
+	if (m_egl_owns_display == true)
+		ndm::egl_release_display();
+	m_egl_display = EGL_NO_DISPLAY;
+
+	m_loaded = false;
+}
+
+void ndm::GLContext::make_current()
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if (eglMakeCurrent(m_egl_display, m_egl_surface, m_egl_surface, m_egl_context) == EGL_FALSE)
+		throw std::runtime_error("Can't make the current thread an OpenGL context !");
+}
+
+void ndm::GLContext::release_current()
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if (eglMakeCurrent(m_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_FALSE)
+		throw std::runtime_error("Can't release the OpenGL context of the current thread !");
+}
+
+void ndm::GLContext::read_framebuffer(ndm::GLFramebufferImage & image) const
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(eglGetCurrentContext() != m_egl_context)
+		throw std::runtime_error("The OpenGL context is not current on the calling thread !");
+
+	image.width = static_cast<std::uint64_t>(m_egl_surface_width);
+	image.height = static_cast<std::uint64_t>(m_egl_surface_height);
+	image.pixels.resize(image.width * image.height * 4);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_egl_surface_width, m_egl_surface_height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+}
+
+void ndm::GLContext::set_swap_interval(const std::int32_t interval)
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	(void) interval;
+	throw std::runtime_error("A headless OpenGL context is never presented, the swap interval can't be changed !");
+}
+
+void ndm::GLContext::swap_front_and_back()
+{
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back");
+
+	if(m_display_ptr == nullptr)
+		throw std::runtime_error("There is no display bound to this GLContext !");
+
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(eglGetCurrentContext() == EGL_NO_CONTEXT)
+		throw std::runtime_error("The current thread doesn't have an OpenGL context !");
+
+	// Swapping a pbuffer does nothing, so the frame waits for the end of its rendering instead : the frame statistics measure
+	// the real cost of the frame like the swap of a window does when the driver throttles the frames
+	const std::chrono::steady_clock::time_point swap_begin = std::chrono::steady_clock::now();
+	eglSwapBuffers(m_egl_display, m_egl_surface);
+	glFinish();
+	m_frame_timer.record(swap_begin, std::chrono::steady_clock::now());
+	m_render_scale.update(m_frame_timer.get_statistics(), m_swap_interval);
+	m_display_ptr->acknowledge_resize();
+
+	resize_egl_surface();
+}
+
+void ndm::GLContext::resize_egl_surface()
+{
+	// Follow the size of the display, the content of the pbuffer is lost like the back buffer of a resized window
+	const EGLint width = static_cast<EGLint>(m_display_ptr->get_framebuffer_width());
+	const EGLint height = static_cast<EGLint>(m_display_ptr->get_framebuffer_height());
+	if (width != m_egl_surface_width || height != m_egl_surface_height)
+	{
+		EGLSurface surface = egl_create_pbuffer(m_egl_display, m_egl_config, width, height);
+		if (surface == EGL_NO_SURFACE)
+			throw std::runtime_error("Can't resize the pbuffer of the OpenGL context !");
+
+		if (eglMakeCurrent(m_egl_display, surface, surface, m_egl_context) == EGL_FALSE)
+		{
+			eglDestroySurface(m_egl_display, surface);
+			throw std::runtime_error("Can't make the current thread an OpenGL context !");
+		}
+
+		eglDestroySurface(m_egl_display, m_egl_surface);
+		m_egl_surface = surface;
+		m_egl_surface_width = width;
+		m_egl_surface_height = height;
+	}
+}
+
+void ndm::GLContext::swap_front_and_back(const ndm::DamageRegion & damage)
+{
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back(damage)");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(m_egl_swap_buffers_with_damage == false || m_display_ptr == nullptr)
+	{
+		swap_front_and_back();
+		return;
+	}
+
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(eglGetCurrentContext() == EGL_NO_CONTEXT)
+		throw std::runtime_error("The current thread doesn't have an OpenGL context !");
+
+	// An empty damage presents the whole frame, and so does a frame of the previous size : the surface is resized after the
+	// swap, its rectangles are not the rectangles of the display anymore
+	if(damage.empty() == true || m_display_ptr->get_framebuffer_width() != m_egl_surface_width || m_display_ptr->get_framebuffer_height() != m_egl_surface_height)
+	{
+		swap_front_and_back();
+		return;
+	}
+
+	// EGL counts the rows from the bottom of the surface, zero rectangles (all of them are outside) present the whole surface
+	std::array<EGLint, ndm::DamageRegion::capacity * 4> rects = {};
+	EGLint count = 0;
+	for (const ndm::DisplayRect & rect : damage)
+	{
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, m_egl_surface_width, m_egl_surface_height);
+		if (clipped.width <= 0 || clipped.height <= 0)
+			continue;
+
+		rects[count * 4 + 0] = static_cast<EGLint>(clipped.x);
+		rects[count * 4 + 1] = static_cast<EGLint>(m_egl_surface_height - clipped.y - clipped.height);
+		rects[count * 4 + 2] = static_cast<EGLint>(clipped.width);
+		rects[count * 4 + 3] = static_cast<EGLint>(clipped.height);
+		count++;
+	}
+
+	const std::chrono::steady_clock::time_point swap_begin = std::chrono::steady_clock::now();
+	ndm::eglSwapBuffersWithDamageKHR(m_egl_display, m_egl_surface, rects.data(), count);
+	glFinish();
+	m_frame_timer.record(swap_begin, std::chrono::steady_clock::now());
+	m_render_scale.update(m_frame_timer.get_statistics(), m_swap_interval);
+	m_display_ptr->acknowledge_resize();
+
+	resize_egl_surface();
+}
+
+#endif
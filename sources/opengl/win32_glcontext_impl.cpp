@@ -1,24 +1,53 @@
 // Only compile on Windows (x32 or x64)
 #if defined(_WIN32) || defined(_WIN64)
 
+// STD includes
+#include <mutex>
+
 // NDM includes
 #include <ndm/opengl/gl_context.hpp>
 
-void ndm::GLContext::load(const GLContextParams & params)
-{
-	if(m_display_ptr == nullptr)
-		throw std::exception("There is no display bound to this GLContext !");
+// GL includes
+#include <GL/gl.h>
 
-	if(m_display_ptr->is_loaded() == false)
-		throw std::exception("The display is not loaded !");
+// Set once the WGL functions are loaded
+static std::once_flag wgl_functions_loaded;
 
-	if(wglGetCurrentContext() != nullptr)
-		throw std::exception("The current thread already has an OpenGL context !");
+// The fake window and its legacy context, released in the reverse order of their creation on every exit path so a failed
+// bootstrap can be retried by the next load
+struct Win32FakeWindow
+{
+	HINSTANCE instance = nullptr;
+	bool registered = false;
+	HWND handle = nullptr;
+	HDC device_context = nullptr;
+	HGLRC gl_context = nullptr;
 
-	// Fake window
-	HDC fake_device_context = nullptr;
-	HGLRC fake_gl_device_context = nullptr;
-	HWND fake_handle = nullptr;
+	inline ~Win32FakeWindow()
+	{
+		if (gl_context != nullptr)
+		{
+			if (wglGetCurrentContext() == gl_context)
+				wglMakeCurrent(nullptr, nullptr);
+			wglDeleteContext(gl_context);
+		}
+
+		if (device_context != nullptr)
+			ReleaseDC(handle, device_context);
+
+		if (handle != nullptr)
+			DestroyWindow(handle);
+
+		if (registered == true)
+			UnregisterClassA("FakeWindow", instance);
+	}
+};
+
+// The WGL extension functions can only be retrieved with a current OpenGL context, so a fake window and a legacy context are created to load them
+static void win32_load_wgl_functions(HINSTANCE instance)
+{
+	Win32FakeWindow fake_window;
+	fake_window.instance = instance;
 
 	// Register fake Win32 class
 	WNDCLASSEXA fake_window_class = {};
@@ -26,24 +55,27 @@ void ndm::GLContext::load(const GLContextParams & params)
 	fake_window_class.cbSize = sizeof(WNDCLASSEXA);
 	fake_window_class.lpszClassName = "FakeWindow";
 	fake_window_class.lpfnWndProc = ndm::win32_process_events;
-	fake_window_class.hInstance = m_display_ptr->get_win32_instance();
+	fake_window_class.hInstance = instance;
 	fake_window_class.hbrBackground = (HBRUSH)(1 + COLOR_WINDOW);
 	fake_window_class.style = CS_OWNDC | CS_VREDRAW | CS_HREDRAW;
 	if (RegisterClassExA(&fake_window_class) == 0)
 		throw std::exception("Can't register the window class !");
+	fake_window.registered = true;
 
 	// Create the fake window
-	fake_handle = CreateWindowExA(
+	fake_window.handle = CreateWindowExA(
 		0, "FakeWindow", "FakeWindow",
 		WS_CLIPSIBLINGS | WS_CLIPCHILDREN,
 		0, 0, 1, 1,
 		nullptr, nullptr,
-		m_display_ptr->get_win32_instance(), nullptr
+		instance, nullptr
 	);
+	if (fake_window.handle == nullptr)
+		throw std::exception("Can't create the window !");
 
 	// Get the fake device context
-	fake_device_context = GetDC(fake_handle);
-	if (fake_device_context == nullptr)
+	fake_window.device_context = GetDC(fake_window.handle);
+	if (fake_window.device_context == nullptr)
 		throw std::exception("Can't retrieve the device context !");
 
 	// Choose the fake pixel format
@@ -54,38 +86,77 @@ void ndm::GLContext::load(const GLContextParams & params)
 	fake_pixel_format_descriptor.dwFlags = PFD_SUPPORT_OPENGL;
 	fake_pixel_format_descriptor.iPixelType = PFD_TYPE_RGBA;
 	fake_pixel_format_descriptor.cColorBits = 8;
-	int fake_pixel_format = ChoosePixelFormat(fake_device_context, &fake_pixel_format_descriptor);
-	if (SetPixelFormat(fake_device_context, fake_pixel_format, &fake_pixel_format_descriptor) == FALSE)
+	int fake_pixel_format = ChoosePixelFormat(fake_window.device_context, &fake_pixel_format_descriptor);
+	if (SetPixelFormat(fake_window.device_context, fake_pixel_format, &fake_pixel_format_descriptor) == FALSE)
 		throw std::exception("Can't choose a pixel format !");
 
 	// Create the fake GL Context
-	fake_gl_device_context = wglCreateContext(fake_device_context);
-	if (fake_gl_device_context == nullptr)
+	fake_window.gl_context = wglCreateContext(fake_window.device_context);
+	if (fake_window.gl_context == nullptr)
 		throw std::exception("Can't create an OpenGL context !");
 
 	// Set the fake OpenGL context active
-	if (wglMakeCurrent(fake_device_context, fake_gl_device_context) == FALSE)
+	if (wglMakeCurrent(fake_window.device_context, fake_window.gl_context) == FALSE)
 		throw std::exception("Can't make the current thread an OpenGL context !");
 
-	// Load WGL functions
+	// Load WGL functions, the fake window and its context are destroyed when leaving
 	ndm::wglChoosePixelFormatARB = (PFNWGLCHOOSEPIXELFORMATARBPROC) wglGetProcAddress("wglChoosePixelFormatARB");
 	ndm::wglCreateContextAttribsARB = (PFNWGLCREATECONTEXTATTRIBSARBPROC) wglGetProcAddress("wglCreateContextAttribsARB");
 	ndm::wglSwapIntervalEXT = (PFNWGLSWAPINTERVALEXTPROC) wglGetProcAddress("wglSwapIntervalEXT");
+	ndm::wglGetExtensionsStringARB = (PFNWGLGETEXTENSIONSSTRINGARBPROC) wglGetProcAddress("wglGetExtensionsStringARB");
+}
 
-	// Delete the fake GL context
-	if (wglDeleteContext(fake_gl_device_context) == FALSE)
-		throw std::exception("Can't delete the current OpenGL context !");
+void ndm::GLContext::load(const GLContextParams & params)
+{
+	NDM_TRACE_SCOPE("GLContext::load");
+
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
+		throw std::exception("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::exception("The OpenGL context is already loaded !");
+
+	if(wglGetCurrentContext() != nullptr)
+		throw std::exception("The current thread already has an OpenGL context !");
 
-	// Remove the current fake OpenGL context
-	wglMakeCurrent(nullptr, nullptr);
+	if(params.shared_context != nullptr && params.shared_context->m_loaded == false)
+		throw std::exception("The shared OpenGL context is not loaded !");
 
-	// Destroy the fake window
-	if (DestroyWindow(fake_handle) == false)
-		throw std::exception("Can't destroy the window properly !");
+	HINSTANCE instance = m_display_ptr != nullptr ? m_display_ptr->get_win32_instance() : GetModuleHandle(nullptr);
 
-	// Unregister the fake class
-	if (UnregisterClassA("FakeWindow", m_display_ptr->get_win32_instance()) == 0)
-		throw std::exception("can't unregister the window class !");
+	// Load the WGL functions once for the whole process, the next contexts skip the fake window
+	std::call_once(wgl_functions_loaded, win32_load_wgl_functions, instance);
+	if (ndm::wglChoosePixelFormatARB == nullptr || ndm::wglCreateContextAttribsARB == nullptr)
+		throw std::exception("The driver doesn't support WGL_ARB_pixel_format and WGL_ARB_create_context !");
+
+	// A headless context renders to a hidden window that is never shown
+	m_headless_handle = nullptr;
+	if (m_display_ptr == nullptr)
+	{
+		WNDCLASSEXA headless_window_class = {};
+		std::memset(&headless_window_class, 0, sizeof(WNDCLASSEXA));
+		if (GetClassInfoExA(instance, "NDMHeadlessClass", &headless_window_class) == 0)
+		{
+			headless_window_class.cbSize = sizeof(WNDCLASSEXA);
+			headless_window_class.lpszClassName = "NDMHeadlessClass";
+			headless_window_class.lpfnWndProc = DefWindowProcA;
+			headless_window_class.hInstance = instance;
+			headless_window_class.style = CS_OWNDC;
+			if (RegisterClassExA(&headless_window_class) == 0)
+				throw std::exception("Can't register the window class !");
+		}
+
+		m_headless_handle = CreateWindowExA(0, "NDMHeadlessClass", "NDMHeadless", WS_POPUP, 0, 0, 1, 1, nullptr, nullptr, instance, nullptr);
+		if (m_headless_handle == nullptr)
+			throw std::exception("Can't create the window of the headless OpenGL context !");
+
+		m_device_context = GetDC(m_headless_handle);
+	} else {
+		m_device_context = m_display_ptr->get_win32_device_context();
+	}
+
+	if (m_device_context == nullptr)
+		throw std::exception("Can't retrieve the device context !");
 
 	// Choose pixel format
 	const int pixel_format_attributes[] =
@@ -106,15 +177,15 @@ void ndm::GLContext::load(const GLContextParams & params)
 
 	int pixel_format = -1;
 	unsigned int number_of_formats = 0;
-	if (ndm::wglChoosePixelFormatARB(m_display_ptr->get_win32_device_context(), pixel_format_attributes, nullptr, 1, &pixel_format, &number_of_formats) == FALSE)
+	if (ndm::wglChoosePixelFormatARB(m_device_context, pixel_format_attributes, nullptr, 1, &pixel_format, &number_of_formats) == FALSE)
 		throw std::exception("Can't choose a pixel format with WGL !");
 
 	PIXELFORMATDESCRIPTOR pixel_format_descriptor = {};
 	std::memset(&pixel_format_descriptor, 0, sizeof(PIXELFORMATDESCRIPTOR));
-	if (DescribePixelFormat(m_display_ptr->get_win32_device_context(), pixel_format, sizeof(PIXELFORMATDESCRIPTOR), &pixel_format_descriptor) == 0)
+	if (DescribePixelFormat(m_device_context, pixel_format, sizeof(PIXELFORMATDESCRIPTOR), &pixel_format_descriptor) == 0)
 		throw std::exception("Can't describe a pixel format !");
 
-	if (SetPixelFormat(m_display_ptr->get_win32_device_context(), pixel_format, &pixel_format_descriptor) == false)
+	if (SetPixelFormat(m_device_context, pixel_format, &pixel_format_descriptor) == false)
 		throw std::exception("Can't set the pixel format !");
 
 	// Set context attributes array
@@ -135,30 +206,40 @@ void ndm::GLContext::load(const GLContextParams & params)
 		0
 	};
 
-	m_gl_device_context = ndm::wglCreateContextAttribsARB(m_display_ptr->get_win32_device_context(), nullptr, context_attributes);
+	HGLRC shared_gl_device_context = params.shared_context != nullptr ? params.shared_context->m_gl_device_context : nullptr;
+	m_gl_device_context = ndm::wglCreateContextAttribsARB(m_device_context, shared_gl_device_context, context_attributes);
 	if (m_gl_device_context == nullptr)
 		throw std::exception("Can't create an OpenGL context with WGL !");
 
 	// Make current thread an OpenGL context
-	if (wglMakeCurrent(m_display_ptr->get_win32_device_context(), m_gl_device_context) == FALSE)
+	if (wglMakeCurrent(m_device_context, m_gl_device_context) == FALSE)
 		throw std::exception("Can't make the current thread an OpenGL context !");
 
+	// Check the swap interval modes supported by the driver
+	const char * extensions = ndm::wglGetExtensionsStringARB != nullptr ? ndm::wglGetExtensionsStringARB(m_device_context) : nullptr;
+	m_swap_control.swap_interval = m_display_ptr != nullptr && ndm::wglSwapIntervalEXT != nullptr;
+	m_swap_control.immediate = m_swap_control.swap_interval;
+	m_swap_control.adaptive = m_swap_control.swap_interval && ndm::gl_has_extension(extensions, "WGL_EXT_swap_control_tear");
+
+	// The refresh rate of the monitor is used to count the missed intervals, 0 and 1 mean the default rate of the hardware
+	const int refresh_rate = GetDeviceCaps(m_device_context, VREFRESH);
+	m_frame_timer.set_refresh_period(std::chrono::nanoseconds(1000000000 / (refresh_rate > 1 ? refresh_rate : 60)));
+	m_frame_timer.reset();
+
 	m_loaded = true;
 }
 
 void ndm::GLContext::unload()
 {
-	if(m_display_ptr == nullptr)
-		throw std::exception("There is no display bound to this GLContext !");
-
-	if(m_display_ptr->is_loaded() == false)
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
 		throw std::exception("The display is not loaded !");
 
 	if(m_loaded == false)
 		throw std::exception("The OpenGL context is not loaded !");
 
-	if(wglGetCurrentContext() == nullptr)
-		throw std::exception("The current thread doesn't have an OpenGL context !");
+	// Make the current context null if it is this one
+	if(wglGetCurrentContext() == m_gl_device_context)
+		wglMakeCurrent(nullptr, nullptr);
 
 	// Delete the GL context
 	if (m_gl_device_context == nullptr)
@@ -166,24 +247,80 @@ void ndm::GLContext::unload()
 
 	if (wglDeleteContext(m_gl_device_context) == FALSE)
 		throw std::exception("Can't delete the current OpenGL context !");
+	m_gl_device_context = nullptr;
 
-	// Make the current context null
-	wglMakeCurrent(nullptr, nullptr);
+	// Destroy the hidden window of a headless context
+	if (m_headless_handle != nullptr)
+	{
+		ReleaseDC(m_headless_handle, m_device_context);
+		DestroyWindow(m_headless_handle);
+		m_headless_handle = nullptr;
+	}
+	m_device_context = nullptr;
 
 	m_loaded = false;
 }
 
-void ndm::GLContext::set_vertical_sync(const bool vertical_sync) const
+void ndm::GLContext::make_current()
 {
+	if(m_loaded == false)
+		throw std::exception("The OpenGL context is not loaded !");
+
+	if (wglMakeCurrent(m_device_context, m_gl_device_context) == FALSE)
+		throw std::exception("Can't make the current thread an OpenGL context !");
+}
+
+void ndm::GLContext::release_current()
+{
+	if(m_loaded == false)
+		throw std::exception("The OpenGL context is not loaded !");
+
+	if (wglMakeCurrent(nullptr, nullptr) == FALSE)
+		throw std::exception("Can't release the OpenGL context of the current thread !");
+}
+
+void ndm::GLContext::read_framebuffer(ndm::GLFramebufferImage & image) const
+{
+	if(m_loaded == false)
+		throw std::exception("The OpenGL context is not loaded !");
+
+	if(wglGetCurrentContext() != m_gl_device_context)
+		throw std::exception("The OpenGL context is not current on the calling thread !");
+
+	// The framebuffer of a window has its client size, the hidden window of a headless context has a single pixel
+	const GLsizei width = m_display_ptr != nullptr ? static_cast<GLsizei>(m_display_ptr->get_framebuffer_width()) : 1;
+	const GLsizei height = m_display_ptr != nullptr ? static_cast<GLsizei>(m_display_ptr->get_framebuffer_height()) : 1;
+	image.width = static_cast<std::uint64_t>(width);
+	image.height = static_cast<std::uint64_t>(height);
+	image.pixels.resize(image.width * image.height * 4);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+}
+
+void ndm::GLContext::set_swap_interval(const std::int32_t interval)
+{
+	if(m_loaded == false)
+		throw std::exception("The OpenGL context is not loaded !");
+
+	if(m_swap_control.swap_interval == false || ndm::wglSwapIntervalEXT == nullptr)
+		throw std::exception("The driver doesn't support WGL_EXT_swap_control !");
+
+	if(interval < 0 && m_swap_control.adaptive == false)
+		throw std::exception("The driver doesn't support WGL_EXT_swap_control_tear !");
+
 	// Set the swap interval
-	if (ndm::wglSwapIntervalEXT != nullptr && vertical_sync == true)
-		ndm::wglSwapIntervalEXT(1);
-	else if (ndm::wglSwapIntervalEXT != nullptr && vertical_sync == false)
-		ndm::wglSwapIntervalEXT(0);
+	if (ndm::wglSwapIntervalEXT(interval) == FALSE)
+		throw std::exception("Can't set the swap interval !");
+
+	m_swap_interval = interval;
+	m_frame_timer.set_swap_interval(interval);
 }
 
-void ndm::GLContext::swap_front_and_back() const 
+void ndm::GLContext::swap_front_and_back()
 {
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back");
+
 	if(m_display_ptr == nullptr)
 		throw std::exception("There is no display bound to this GLContext !");
 
@@ -193,14 +330,29 @@ void ndm::GLContext::swap_front_and_back() const
 	if(m_loaded == false)
 		throw std::exception("The OpenGL context is not loaded !");
 
-	if(m_display_ptr->get_win32_device_context() == nullptr)
+	if(m_device_context == nullptr)
 		throw std::exception("There is no device context !");
 
 	if(wglGetCurrentContext() == nullptr)
 		throw std::exception("The current thread doesn't have an OpenGL context !");
 
 	// Swap the back and front
-	SwapBuffers(m_display_ptr->get_win32_device_context());
+	const std::chrono::steady_clock::time_point swap_begin = std::chrono::steady_clock::now();
+	SwapBuffers(m_device_context);
+	m_frame_timer.record(swap_begin, std::chrono::steady_clock::now());
+	m_render_scale.update(m_frame_timer.get_statistics(), m_swap_interval);
+
+	// The frame has the size of the last resize caught, a synchronous resize can be shown by the window manager
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::GLContext::swap_front_and_back(const ndm::DamageRegion & damage)
+{
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back(damage)");
+
+	// WGL has no partial swap, the whole back buffer is presented
+	static_cast<void>(damage);
+	swap_front_and_back();
 }
 
-#endif
\ No newline at end of file
+#endif
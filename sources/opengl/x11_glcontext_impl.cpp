@@ -0,0 +1,399 @@
+// Only compile on Linux, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// STD includes
+#include <mutex>
+#include <algorithm>
+
+// NDM includes
+#include <ndm/opengl/gl_context.hpp>
+
+// Check if a GLX extension is in the extensions string of the screen
+static bool glx_has_extension(::Display * display, const int screen, const char * extension)
+{
+	return ndm::gl_has_extension(glXQueryExtensionsString(display, screen), extension);
+}
+
+// Set once the GLX functions are loaded
+static std::once_flag glx_functions_loaded;
+
+// Unlike WGL, GLX can retrieve the extension functions without a current OpenGL context
+static void glx_load_functions()
+{
+	ndm::glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXCreateContextAttribsARB"));
+	ndm::glXSwapIntervalEXT = (PFNGLXSWAPINTERVALEXTPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXSwapIntervalEXT"));
+	ndm::glXSwapIntervalMESA = (PFNGLXSWAPINTERVALMESAPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXSwapIntervalMESA"));
+	ndm::glXSwapIntervalSGI = (PFNGLXSWAPINTERVALSGIPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXSwapIntervalSGI"));
+	ndm::glXGetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXGetSyncValuesOML"));
+	ndm::glXGetMscRateOML = (PFNGLXGETMSCRATEOMLPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXGetMscRateOML"));
+	ndm::glXCopySubBufferMESA = (PFNGLXCOPYSUBBUFFERMESAPROC) glXGetProcAddressARB(reinterpret_cast<const GLubyte *>("glXCopySubBufferMESA"));
+}
+
+void ndm::GLContext::load(const GLContextParams & params)
+{
+	NDM_TRACE_SCOPE("GLContext::load");
+
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::runtime_error("The OpenGL context is already loaded !");
+
+	if(glXGetCurrentContext() != nullptr)
+		throw std::runtime_error("The current thread already has an OpenGL context !");
+
+	if(params.shared_context != nullptr && params.shared_context->m_loaded == false)
+		throw std::runtime_error("The shared OpenGL context is not loaded !");
+
+	// Load the GLX functions once for the whole process, the next contexts skip this step
+	std::call_once(glx_functions_loaded, glx_load_functions);
+
+	// A context bound to a display uses its connection, a headless context uses the connection of the context it shares
+	// its objects with, so both contexts live on the same GLX screen, or its own connection otherwise
+	m_glx_owns_display = false;
+	int screen = 0;
+	if (m_display_ptr != nullptr)
+	{
+		m_glx_display = m_display_ptr->get_x11_display();
+		screen = m_display_ptr->get_x11_screen();
+	} else if (params.shared_context != nullptr) {
+		m_glx_display = params.shared_context->m_glx_display;
+		screen = DefaultScreen(m_glx_display);
+	} else {
+		m_glx_display = XOpenDisplay(nullptr);
+		if (m_glx_display == nullptr)
+			throw std::runtime_error("Can't open the X display !");
+		m_glx_owns_display = true;
+		screen = DefaultScreen(m_glx_display);
+	}
+
+	try {
+		if (ndm::glXCreateContextAttribsARB == nullptr || glx_has_extension(m_glx_display, screen, "GLX_ARB_create_context") == false)
+			throw std::runtime_error("Can't create an OpenGL context with GLX, GLX_ARB_create_context is not supported !");
+
+		// Choose a framebuffer config, a headless context renders to a pbuffer
+		const int color_component_bits = params.color_bits / 3;
+		const int framebuffer_config_attributes[] =
+		{
+			GLX_X_RENDERABLE, True,
+			GLX_DRAWABLE_TYPE, is_headless() == true ? GLX_PBUFFER_BIT : GLX_WINDOW_BIT,
+			GLX_RENDER_TYPE, GLX_RGBA_BIT,
+			GLX_DOUBLEBUFFER, params.double_buffer,
+			GLX_RED_SIZE, color_component_bits,
+			GLX_GREEN_SIZE, color_component_bits,
+			GLX_BLUE_SIZE, color_component_bits,
+			GLX_ALPHA_SIZE, params.alpha_bits,
+			GLX_DEPTH_SIZE, params.depth_bits,
+			GLX_STENCIL_SIZE, params.stencil_bits,
+			GLX_SAMPLE_BUFFERS, params.samples_buffers,
+			GLX_SAMPLES, params.samples,
+			None
+		};
+
+		int number_of_configs = 0;
+		GLXFBConfig * framebuffer_configs = glXChooseFBConfig(m_glx_display, screen, framebuffer_config_attributes, &number_of_configs);
+		if (framebuffer_configs == nullptr || number_of_configs == 0)
+			throw std::runtime_error("Can't choose a framebuffer config with GLX !");
+
+		// The window is already created, so the config must use the same visual as the window
+		GLXFBConfig framebuffer_config = nullptr;
+		if (is_headless() == true)
+		{
+			framebuffer_config = framebuffer_configs[0];
+		} else {
+			XWindowAttributes window_attributes = {};
+			XGetWindowAttributes(m_glx_display, m_display_ptr->get_x11_window(), &window_attributes);
+			const VisualID window_visual_id = XVisualIDFromVisual(window_attributes.visual);
+
+			for (int i = 0; i < number_of_configs && framebuffer_config == nullptr; i++)
+			{
+				int visual_id = 0;
+				if (glXGetFBConfigAttrib(m_glx_display, framebuffer_configs[i], GLX_VISUAL_ID, &visual_id) == Success && static_cast<VisualID>(visual_id) == window_visual_id)
+					framebuffer_config = framebuffer_configs[i];
+			}
+		}
+
+		XFree(framebuffer_configs);
+		if (framebuffer_config == nullptr)
+			throw std::runtime_error("Can't find a framebuffer config compatible with the visual of the window !");
+
+		// Set context attributes array
+		int flags = 0;
+		if(params.debug_mode == true)
+			flags = flags | GLX_CONTEXT_DEBUG_BIT_ARB;
+
+		int context_profile = GLX_CONTEXT_CORE_PROFILE_BIT_ARB;
+		if(params.profile == ndm::GLContextProfile::COMPATIBILITY_PROFILE)
+			context_profile = GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB;
+
+		const int context_attributes[] =
+		{
+			GLX_CONTEXT_MAJOR_VERSION_ARB, params.major_version,
+			GLX_CONTEXT_MINOR_VERSION_ARB, params.minor_version,
+			GLX_CONTEXT_FLAGS_ARB, flags,
+			GLX_CONTEXT_PROFILE_MASK_ARB, context_profile,
+			None
+		};
+
+		GLXContext shared_glx_context = params.shared_context != nullptr ? params.shared_context->m_glx_context : nullptr;
+		m_glx_context = ndm::glXCreateContextAttribsARB(m_glx_display, framebuffer_config, shared_glx_context, True, context_attributes);
+		XSync(m_glx_display, False);
+		if (m_glx_context == nullptr)
+			throw std::runtime_error("Can't create an OpenGL context with GLX !");
+
+		// Create the drawable of the context
+		m_glx_pbuffer = 0;
+		if (is_headless() == true)
+		{
+			const int pbuffer_attributes[] =
+			{
+				GLX_PBUFFER_WIDTH, 1,
+				GLX_PBUFFER_HEIGHT, 1,
+				None
+			};
+
+			m_glx_pbuffer = glXCreatePbuffer(m_glx_display, framebuffer_config, pbuffer_attributes);
+			if (m_glx_pbuffer == 0)
+			{
+				glXDestroyContext(m_glx_display, m_glx_context);
+				throw std::runtime_error("Can't create the pbuffer of the headless OpenGL context !");
+			}
+
+			m_glx_drawable = m_glx_pbuffer;
+		} else {
+			m_glx_drawable = m_display_ptr->get_x11_window();
+		}
+
+		// Make current thread an OpenGL context
+		if (glXMakeCurrent(m_glx_display, m_glx_drawable, m_glx_context) == False)
+		{
+			if (m_glx_pbuffer != 0)
+				glXDestroyPbuffer(m_glx_display, m_glx_pbuffer);
+			glXDestroyContext(m_glx_display, m_glx_context);
+			throw std::runtime_error("Can't make the current thread an OpenGL context !");
+		}
+
+		// Check the swap interval modes supported by the driver, glXGetProcAddress returns pointers even for unsupported functions
+		const bool ext_swap_control = ndm::glXSwapIntervalEXT != nullptr && glx_has_extension(m_glx_display, screen, "GLX_EXT_swap_control");
+		const bool mesa_swap_control = ndm::glXSwapIntervalMESA != nullptr && glx_has_extension(m_glx_display, screen, "GLX_MESA_swap_control");
+		const bool sgi_swap_control = ndm::glXSwapIntervalSGI != nullptr && glx_has_extension(m_glx_display, screen, "GLX_SGI_swap_control");
+		m_glx_ext_swap_control = ext_swap_control;
+		m_glx_mesa_swap_control = mesa_swap_control;
+		m_swap_control.swap_interval = is_headless() == false && (ext_swap_control || mesa_swap_control || sgi_swap_control);
+		m_swap_control.immediate = m_swap_control.swap_interval && (ext_swap_control || mesa_swap_control);
+		m_swap_control.adaptive = m_swap_control.swap_interval && ext_swap_control && glx_has_extension(m_glx_display, screen, "GLX_EXT_swap_control_tear");
+
+		// The damaged rectangles are copied from the back buffer to the front buffer without swapping the whole buffers
+		m_glx_mesa_copy_sub_buffer = is_headless() == false && ndm::glXCopySubBufferMESA != nullptr && glx_has_extension(m_glx_display, screen, "GLX_MESA_copy_sub_buffer");
+
+		// The frame statistics use the vertical retrace counter of the driver when it is available
+		m_glx_oml_sync_control = is_headless() == false && ndm::glXGetSyncValuesOML != nullptr && glx_has_extension(m_glx_display, screen, "GLX_OML_sync_control");
+
+		std::int32_t numerator = 0;
+		std::int32_t denominator = 0;
+		if (m_glx_oml_sync_control == true && ndm::glXGetMscRateOML != nullptr &&
+			ndm::glXGetMscRateOML(m_glx_display, m_glx_drawable, &numerator, &denominator) == True && numerator > 0)
+			m_frame_timer.set_refresh_period(std::chrono::nanoseconds((1000000000ll * denominator) / numerator));
+		else
+			m_frame_timer.set_refresh_period(std::chrono::nanoseconds(1000000000ll / 60));
+		m_frame_timer.reset();
+	} catch (...) {
+		if (m_glx_owns_display == true)
+			XCloseDisplay(m_glx_display);
+		m_glx_display = nullptr;
+		throw;
+	}
+
+	m_loaded = true;
+}
+
+void ndm::GLContext::unload()
+{
+	if(m_display_ptr != nullptr && m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	// Make the current context null if it is this one
+	if(glXGetCurrentContext() == m_glx_context)
+		glXMakeCurrent(m_glx_display, None, nullptr);
+
+	// Delete the GL context and its drawable
+	glXDestroyContext(m_glx_display, m_glx_context);
+	m_glx_context = nullptr;
+
+	if (m_glx_pbuffer != 0)
+		glXDestroyPbuffer(m_glx_display, m_glx_pbuffer);
+	m_glx_pbuffer = 0;
+
+	if (m_glx_owns_display == true)
+		XCloseDisplay(m_glx_display);
+	m_glx_display = nullptr;
+
+	m_loaded = false;
+}
+
+void ndm::GLContext::make_current()
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if (glXMakeCurrent(m_glx_display, m_glx_drawable, m_glx_context) == False)
+		throw std::runtime_error("Can't make the current thread an OpenGL context !");
+}
+
+void ndm::GLContext::release_current()
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if (glXMakeCurrent(m_glx_display, None, nullptr) == False)
+		throw std::runtime_error("Can't release the OpenGL context of the current thread !");
+}
+
+void ndm::GLContext::read_framebuffer(ndm::GLFramebufferImage & image) const
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(glXGetCurrentContext() != m_glx_context)
+		throw std::runtime_error("The OpenGL context is not current on the calling thread !");
+
+	// The framebuffer of a window has its client size, the pbuffer of a headless context has a single pixel
+	const GLsizei width = m_display_ptr != nullptr ? static_cast<GLsizei>(m_display_ptr->get_framebuffer_width()) : 1;
+	const GLsizei height = m_display_ptr != nullptr ? static_cast<GLsizei>(m_display_ptr->get_framebuffer_height()) : 1;
+	image.width = static_cast<std::uint64_t>(width);
+	image.height = static_cast<std::uint64_t>(height);
+	image.pixels.resize(image.width * image.height * 4);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+}
+
+void ndm::GLContext::set_swap_interval(const std::int32_t interval)
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(m_swap_control.swap_interval == false)
+		throw std::runtime_error("The driver doesn't support GLX_EXT_swap_control, GLX_MESA_swap_control or GLX_SGI_swap_control !");
+
+	if(interval < 0 && m_swap_control.adaptive == false)
+		throw std::runtime_error("The driver doesn't support GLX_EXT_swap_control_tear !");
+
+	if(interval == 0 && m_swap_control.immediate == false)
+		throw std::runtime_error("The driver doesn't support a swap interval of 0 !");
+
+	// Set the swap interval with the best extension available
+	if (m_glx_ext_swap_control == true)
+	{
+		ndm::glXSwapIntervalEXT(m_glx_display, m_glx_drawable, interval);
+	} else if (m_glx_mesa_swap_control == true) {
+		if (ndm::glXSwapIntervalMESA(static_cast<unsigned int>(interval)) != 0)
+			throw std::runtime_error("Can't set the swap interval !");
+	} else {
+		if (ndm::glXSwapIntervalSGI(interval) != 0)
+			throw std::runtime_error("Can't set the swap interval !");
+	}
+
+	m_swap_interval = interval;
+	m_frame_timer.set_swap_interval(interval);
+}
+
+void ndm::GLContext::swap_front_and_back()
+{
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back");
+
+	if(m_display_ptr == nullptr)
+		throw std::runtime_error("There is no display bound to this GLContext !");
+
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(glXGetCurrentContext() == nullptr)
+		throw std::runtime_error("The current thread doesn't have an OpenGL context !");
+
+	// Swap the back and front
+	const std::chrono::steady_clock::time_point swap_begin = std::chrono::steady_clock::now();
+	glXSwapBuffers(m_glx_display, m_glx_drawable);
+	const std::chrono::steady_clock::time_point swap_end = std::chrono::steady_clock::now();
+
+	// Read the vertical retrace counter to count the intervals really elapsed since the last present
+	std::int64_t ust = 0;
+	std::int64_t msc = 0;
+	std::int64_t sbc = 0;
+	if (m_glx_oml_sync_control == true &&
+		ndm::glXGetSyncValuesOML(m_glx_display, m_glx_drawable, &ust, &msc, &sbc) == True)
+		m_frame_timer.record(swap_begin, swap_end, msc);
+	else
+		m_frame_timer.record(swap_begin, swap_end);
+	m_render_scale.update(m_frame_timer.get_statistics(), m_swap_interval);
+
+	// The frame has the size of the last resize caught, a synchronous resize can be shown by the window manager
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::GLContext::swap_front_and_back(const ndm::DamageRegion & damage)
+{
+	NDM_TRACE_SCOPE("GLContext::swap_front_and_back(damage)");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The OpenGL context is not loaded !");
+
+	if(m_glx_mesa_copy_sub_buffer == false)
+	{
+		swap_front_and_back();
+		return;
+	}
+
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(glXGetCurrentContext() == nullptr)
+		throw std::runtime_error("The current thread doesn't have an OpenGL context !");
+
+	// An empty damage presents the whole frame like EGL does, and so does a damage outside of the drawable
+	const std::int64_t width = m_display_ptr->get_framebuffer_width();
+	const std::int64_t height = m_display_ptr->get_framebuffer_height();
+	const bool visible = std::any_of(damage.begin(), damage.end(), [width, height](const ndm::DisplayRect & rect) {
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		return clipped.width > 0 && clipped.height > 0;
+	});
+	if(visible == false)
+	{
+		swap_front_and_back();
+		return;
+	}
+
+	// GLX counts the rows from the bottom of the drawable
+	const std::chrono::steady_clock::time_point swap_begin = std::chrono::steady_clock::now();
+	for (const ndm::DisplayRect & rect : damage)
+	{
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		if (clipped.width > 0 && clipped.height > 0)
+			ndm::glXCopySubBufferMESA(m_glx_display, m_glx_drawable, static_cast<int>(clipped.x), static_cast<int>(height - clipped.y - clipped.height),
+									  static_cast<int>(clipped.width), static_cast<int>(clipped.height));
+	}
+
+	const std::chrono::steady_clock::time_point swap_end = std::chrono::steady_clock::now();
+
+	// The counter is read after the copy too, so the next swap only counts the retraces elapsed since this present
+	std::int64_t ust = 0;
+	std::int64_t msc = 0;
+	std::int64_t sbc = 0;
+	if (m_glx_oml_sync_control == true &&
+		ndm::glXGetSyncValuesOML(m_glx_display, m_glx_drawable, &ust, &msc, &sbc) == True)
+		m_frame_timer.record(swap_begin, swap_end, msc);
+	else
+		m_frame_timer.record(swap_begin, swap_end);
+
+	// The copy doesn't wait for the vertical retrace, its frame time doesn't tell if the frames keep up with the refresh 
+	// rate, so only the full swaps update the render scale
+	m_display_ptr->acknowledge_resize();
+}
+
+#endif
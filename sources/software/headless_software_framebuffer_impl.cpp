@@ -0,0 +1,100 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// STD includes
+#include <algorithm>
+
+// NDM includes
+#include <ndm/software/software_framebuffer.hpp>
+
+void ndm::SoftwareFramebuffer::create_buffers(const std::uint64_t width, const std::uint64_t height)
+{
+	m_width = std::max<std::uint64_t>(1, width);
+	m_height = std::max<std::uint64_t>(1, height);
+	m_stride = m_width * sizeof(std::uint32_t);
+	m_back_buffer = 0;
+
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		m_buffers[i].assign(m_width * m_height, 0);
+		m_pixels[i] = m_buffers[i].data();
+	}
+}
+
+void ndm::SoftwareFramebuffer::destroy_buffers()
+{
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		m_buffers[i].clear();
+		m_buffers[i].shrink_to_fit();
+		m_pixels[i] = nullptr;
+	}
+}
+
+void ndm::SoftwareFramebuffer::load()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::runtime_error("The software framebuffer is already loaded !");
+
+	try {
+		create_buffers(static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_width()), static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_height()));
+	} catch (...) {
+		destroy_buffers();
+		throw;
+	}
+
+	m_loaded = true;
+}
+
+void ndm::SoftwareFramebuffer::unload()
+{
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	destroy_buffers();
+
+	m_loaded = false;
+}
+
+void ndm::SoftwareFramebuffer::present()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	// There is nothing to present on, the front buffer keeps the last frame so it can still be inspected
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::SoftwareFramebuffer::present(const ndm::DamageRegion & damage)
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	if (damage.empty() == true)
+	{
+		present();
+		return;
+	}
+
+	const std::size_t presented = m_back_buffer;
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+	copy_damage(presented, m_back_buffer, damage);
+	m_display_ptr->acknowledge_resize();
+}
+
+bool ndm::SoftwareFramebuffer::is_zero_copy() const noexcept
+{
+	return m_loaded;
+}
+
+#endif
@@ -0,0 +1,163 @@
+// Only compile on Windows (x32 or x64)
+#if defined(_WIN32) || defined(_WIN64)
+
+// STD includes
+#include <algorithm>
+
+// NDM includes
+#include <ndm/software/software_framebuffer.hpp>
+
+void ndm::SoftwareFramebuffer::create_buffers(const std::uint64_t width, const std::uint64_t height)
+{
+	m_width = std::max<std::uint64_t>(1, width);
+	m_height = std::max<std::uint64_t>(1, height);
+	m_stride = m_width * sizeof(std::uint32_t);
+	m_back_buffer = 0;
+	m_pixels.fill(nullptr);
+	m_memory_device_contexts.fill(nullptr);
+	m_bitmaps.fill(nullptr);
+	m_previous_bitmaps.fill(nullptr);
+
+	// A negative height creates a top-down DIB, so the rows are stored like the X11 images
+	BITMAPINFO bitmap_info = {};
+	std::memset(&bitmap_info, 0, sizeof(BITMAPINFO));
+	bitmap_info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bitmap_info.bmiHeader.biWidth = static_cast<LONG>(m_width);
+	bitmap_info.bmiHeader.biHeight = -static_cast<LONG>(m_height);
+	bitmap_info.bmiHeader.biPlanes = 1;
+	bitmap_info.bmiHeader.biBitCount = 32;
+	bitmap_info.bmiHeader.biCompression = BI_RGB;
+
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		m_memory_device_contexts[i] = CreateCompatibleDC(m_display_ptr->get_win32_device_context());
+		if (m_memory_device_contexts[i] == nullptr)
+			throw std::exception("Can't create the memory device context of the software framebuffer !");
+
+		// The pixels of a DIB section are in the memory of the process and are read directly by BitBlt
+		void * pixels = nullptr;
+		m_bitmaps[i] = CreateDIBSection(m_memory_device_contexts[i], &bitmap_info, DIB_RGB_COLORS, &pixels, nullptr, 0);
+		if (m_bitmaps[i] == nullptr || pixels == nullptr)
+			throw std::exception("Can't create the DIB section of the software framebuffer !");
+
+		m_previous_bitmaps[i] = SelectObject(m_memory_device_contexts[i], m_bitmaps[i]);
+		m_pixels[i] = static_cast<std::uint32_t *>(pixels);
+	}
+}
+
+void ndm::SoftwareFramebuffer::destroy_buffers()
+{
+	// The batched GDI calls may still read the bitmaps
+	GdiFlush();
+
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		if (m_memory_device_contexts[i] != nullptr && m_previous_bitmaps[i] != nullptr)
+			SelectObject(m_memory_device_contexts[i], m_previous_bitmaps[i]);
+		m_previous_bitmaps[i] = nullptr;
+
+		if (m_bitmaps[i] != nullptr)
+			DeleteObject(m_bitmaps[i]);
+		m_bitmaps[i] = nullptr;
+
+		if (m_memory_device_contexts[i] != nullptr)
+			DeleteDC(m_memory_device_contexts[i]);
+		m_memory_device_contexts[i] = nullptr;
+
+		m_pixels[i] = nullptr;
+	}
+}
+
+void ndm::SoftwareFramebuffer::load()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::exception("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::exception("The software framebuffer is already loaded !");
+
+	try {
+		create_buffers(static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_width()), static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_height()));
+	} catch (...) {
+		destroy_buffers();
+		throw;
+	}
+
+	m_loaded = true;
+}
+
+void ndm::SoftwareFramebuffer::unload()
+{
+	if(m_loaded == false)
+		throw std::exception("The software framebuffer is not loaded !");
+
+	destroy_buffers();
+
+	m_loaded = false;
+}
+
+void ndm::SoftwareFramebuffer::present()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::exception("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::exception("The software framebuffer is not loaded !");
+
+	BitBlt(m_display_ptr->get_win32_device_context(), 0, 0, static_cast<int>(m_width), static_cast<int>(m_height),
+		   m_memory_device_contexts[m_back_buffer], 0, 0, SRCCOPY);
+
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+
+	// GDI batches its calls, the new back buffer can only be written once the previous BitBlt that read it is done
+	GdiFlush();
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::SoftwareFramebuffer::present(const ndm::DamageRegion & damage)
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::exception("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::exception("The software framebuffer is not loaded !");
+
+	const std::int64_t width = static_cast<std::int64_t>(m_width);
+	const std::int64_t height = static_cast<std::int64_t>(m_height);
+
+	// An empty damage presents the whole back buffer
+	const bool visible = std::any_of(damage.begin(), damage.end(), [width, height](const ndm::DisplayRect & rect) {
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		return clipped.width > 0 && clipped.height > 0;
+	});
+	if (visible == false)
+	{
+		present();
+		return;
+	}
+
+	for (const ndm::DisplayRect & rect : damage)
+	{
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		if (clipped.width <= 0 || clipped.height <= 0)
+			continue;
+
+		BitBlt(m_display_ptr->get_win32_device_context(), static_cast<int>(clipped.x), static_cast<int>(clipped.y), static_cast<int>(clipped.width), 
+			   static_cast<int>(clipped.height), m_memory_device_contexts[m_back_buffer], static_cast<int>(clipped.x), static_cast<int>(clipped.y), SRCCOPY);
+	}
+
+	const std::size_t presented = m_back_buffer;
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+
+	// Wait for the BitBlt calls, and bring the new back buffer up to date with the presented frame
+	GdiFlush();
+	copy_damage(presented, m_back_buffer, damage);
+	m_display_ptr->acknowledge_resize();
+}
+
+bool ndm::SoftwareFramebuffer::is_zero_copy() const noexcept
+{
+	return m_loaded;
+}
+
+#endif
@@ -0,0 +1,327 @@
+// Only compile on Linux, the headless build uses EGL instead of X11
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// STD includes
+#include <cstdlib>
+#include <algorithm>
+
+// Linux includes
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+// NDM includes
+#include <ndm/software/software_framebuffer.hpp>
+
+// Set by the error handler when the server refuses to attach a shared memory segment (e.g. a remote connection)
+static bool x11_shm_attach_failed = false;
+
+static int x11_shm_error_handler(::Display * display, XErrorEvent * error)
+{
+	(void) display;
+	(void) error;
+	x11_shm_attach_failed = true;
+	return 0;
+}
+
+// Find the completion event of the oldest image still read by the server
+static Bool x11_is_shm_completion(::Display * display, XEvent * event, XPointer arg)
+{
+	(void) display;
+	return event->type == *reinterpret_cast<int *>(arg) ? True : False;
+}
+
+void ndm::SoftwareFramebuffer::create_buffers(const std::uint64_t width, const std::uint64_t height)
+{
+	::Display * display = m_display_ptr->m_display;
+
+	XWindowAttributes window_attributes = {};
+	XGetWindowAttributes(display, m_display_ptr->m_window, &window_attributes);
+
+	m_width = std::max<std::uint64_t>(1, width);
+	m_height = std::max<std::uint64_t>(1, height);
+	m_back_buffer = 0;
+	m_images.fill(nullptr);
+	m_pixels.fill(nullptr);
+	m_shm_tickets.fill(0);
+	for (XShmSegmentInfo & segment : m_shm_segments)
+	{
+		segment.shmid = -1;
+		segment.shmaddr = nullptr;
+	}
+
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		XShmSegmentInfo & segment = m_shm_segments[i];
+		if (m_shm == true)
+		{
+			m_images[i] = XShmCreateImage(display, window_attributes.visual, static_cast<unsigned int>(window_attributes.depth), ZPixmap, nullptr, &segment,
+										  static_cast<unsigned int>(m_width), static_cast<unsigned int>(m_height));
+			if (m_images[i] == nullptr)
+				throw std::runtime_error("Can't create the shared image of the software framebuffer !");
+
+			segment.shmid = shmget(IPC_PRIVATE, static_cast<std::size_t>(m_images[i]->bytes_per_line) * m_images[i]->height, IPC_CREAT | 0600);
+			if (segment.shmid < 0)
+				throw std::runtime_error("Can't create the shared memory segment of the software framebuffer !");
+
+			segment.shmaddr = m_images[i]->data = static_cast<char *>(shmat(segment.shmid, nullptr, 0));
+			segment.readOnly = False;
+			if (segment.shmaddr == reinterpret_cast<char *>(-1))
+			{
+				segment.shmaddr = m_images[i]->data = nullptr;
+				throw std::runtime_error("Can't attach the shared memory segment of the software framebuffer !");
+			}
+
+			XShmAttach(display, &segment);
+			XSync(display, False);
+
+			// The segment is destroyed as soon as the client and the server detach it, even if the process crashes
+			shmctl(segment.shmid, IPC_RMID, nullptr);
+		} else {
+			m_images[i] = XCreateImage(display, window_attributes.visual, static_cast<unsigned int>(window_attributes.depth), ZPixmap, 0, nullptr,
+									   static_cast<unsigned int>(m_width), static_cast<unsigned int>(m_height), 32, 0);
+			if (m_images[i] == nullptr)
+				throw std::runtime_error("Can't create the image of the software framebuffer !");
+
+			// Freed by XDestroyImage
+			m_images[i]->data = static_cast<char *>(std::malloc(static_cast<std::size_t>(m_images[i]->bytes_per_line) * m_images[i]->height));
+			if (m_images[i]->data == nullptr)
+				throw std::runtime_error("Can't allocate the image of the software framebuffer !");
+		}
+
+		if (m_images[i]->bits_per_pixel != 32)
+			throw std::runtime_error("The visual of the display doesn't use 32 bits per pixel !");
+
+		m_pixels[i] = reinterpret_cast<std::uint32_t *>(m_images[i]->data);
+	}
+
+	m_stride = static_cast<std::uint64_t>(m_images[0]->bytes_per_line);
+}
+
+void ndm::SoftwareFramebuffer::destroy_buffers()
+{
+	::Display * display = m_display_ptr->m_display;
+
+	// The server may still read the images, the last completion is enough because the requests are processed in order
+	if (m_shm == true)
+		wait_shm_completion(*std::max_element(m_shm_tickets.begin(), m_shm_tickets.end()));
+
+	for (std::size_t i = 0; i < buffer_count; i++)
+	{
+		XShmSegmentInfo & segment = m_shm_segments[i];
+		if (segment.shmaddr != nullptr)
+		{
+			XShmDetach(display, &segment);
+			XSync(display, False);
+			shmdt(segment.shmaddr);
+			segment.shmaddr = nullptr;
+		}
+
+		// The data of a shared image is the segment, so XDestroyImage must not free it
+		if (m_images[i] != nullptr)
+		{
+			if (m_shm == true)
+				m_images[i]->data = nullptr;
+			XDestroyImage(m_images[i]);
+			m_images[i] = nullptr;
+		}
+
+		m_pixels[i] = nullptr;
+	}
+}
+
+void ndm::SoftwareFramebuffer::load()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == true)
+		throw std::runtime_error("The software framebuffer is already loaded !");
+
+	::Display * display = m_display_ptr->m_display;
+
+	// MIT-SHM is only available when the client and the server share the memory, a remote server refuses to attach the segment
+	m_shm = XShmQueryExtension(display) == True;
+	if (m_shm == true)
+	{
+		m_display_ptr->m_shm_completion_type.store(XShmGetEventBase(display) + ShmCompletion, std::memory_order_relaxed);
+
+		// Try to attach a small segment to know if the server can read the memory of the client
+		XShmSegmentInfo segment = {};
+		segment.shmid = shmget(IPC_PRIVATE, 4096, IPC_CREAT | 0600);
+		segment.shmaddr = segment.shmid >= 0 ? static_cast<char *>(shmat(segment.shmid, nullptr, 0)) : reinterpret_cast<char *>(-1);
+		segment.readOnly = False;
+		if (segment.shmaddr == reinterpret_cast<char *>(-1))
+		{
+			m_shm = false;
+		} else {
+			XSync(display, False);
+			x11_shm_attach_failed = false;
+			int (* previous_handler)(::Display *, XErrorEvent *) = XSetErrorHandler(x11_shm_error_handler);
+			XShmAttach(display, &segment);
+			XSync(display, False);
+			XSetErrorHandler(previous_handler);
+			m_shm = x11_shm_attach_failed == false;
+
+			if (m_shm == true)
+			{
+				XShmDetach(display, &segment);
+				XSync(display, False);
+			}
+			shmdt(segment.shmaddr);
+		}
+
+		if (segment.shmid >= 0)
+			shmctl(segment.shmid, IPC_RMID, nullptr);
+	}
+
+	m_gc = XCreateGC(display, m_display_ptr->m_window, 0, nullptr);
+
+	try {
+		create_buffers(static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_width()), static_cast<std::uint64_t>(m_display_ptr->get_framebuffer_height()));
+	} catch (...) {
+		destroy_buffers();
+		XFreeGC(display, m_gc);
+		throw;
+	}
+
+	m_loaded = true;
+}
+
+void ndm::SoftwareFramebuffer::unload()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	destroy_buffers();
+	XFreeGC(m_display_ptr->m_display, m_gc);
+	m_gc = nullptr;
+
+	m_loaded = false;
+}
+
+void ndm::SoftwareFramebuffer::present()
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	::Display * display = m_display_ptr->m_display;
+	const unsigned int width = static_cast<unsigned int>(m_width);
+	const unsigned int height = static_cast<unsigned int>(m_height);
+
+	if (m_shm == true)
+	{
+		// The server reads the segment itself and sends a completion event when it has finished, the ticket is the number
+		// of images sent on the connection so it matches the number of completions when this one is received
+		XShmPutImage(display, m_display_ptr->m_window, m_gc, m_images[m_back_buffer], 0, 0, 0, 0, width, height, True);
+		m_shm_tickets[m_back_buffer] = ++m_display_ptr->m_shm_submissions;
+	} else {
+		// The image is copied in the request, so the buffer can be written again immediately
+		XPutImage(display, m_display_ptr->m_window, m_gc, m_images[m_back_buffer], 0, 0, 0, 0, width, height);
+	}
+	XFlush(display);
+
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+
+	// Wait until the server has read the new back buffer
+	if (m_shm == true)
+		wait_shm_completion(m_shm_tickets[m_back_buffer]);
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::SoftwareFramebuffer::present(const ndm::DamageRegion & damage)
+{
+	if(m_display_ptr->is_loaded() == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if(m_loaded == false)
+		throw std::runtime_error("The software framebuffer is not loaded !");
+
+	::Display * display = m_display_ptr->m_display;
+	const std::int64_t width = static_cast<std::int64_t>(m_width);
+	const std::int64_t height = static_cast<std::int64_t>(m_height);
+
+	// Only the last image asks for a completion event, the server reads the images in order
+	const ndm::DisplayRect * last = nullptr;
+	for (const ndm::DisplayRect & rect : damage)
+	{
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		if (clipped.width > 0 && clipped.height > 0)
+			last = &rect;
+	}
+
+	// An empty damage presents the whole back buffer
+	if (last == nullptr)
+	{
+		present();
+		return;
+	}
+
+	for (const ndm::DisplayRect & rect : damage)
+	{
+		const ndm::DisplayRect clipped = ndm::DamageRegion::clip(rect, width, height);
+		if (clipped.width <= 0 || clipped.height <= 0)
+			continue;
+
+		const int x = static_cast<int>(clipped.x);
+		const int y = static_cast<int>(clipped.y);
+		const unsigned int rect_width = static_cast<unsigned int>(clipped.width);
+		const unsigned int rect_height = static_cast<unsigned int>(clipped.height);
+		if (m_shm == true)
+			XShmPutImage(display, m_display_ptr->m_window, m_gc, m_images[m_back_buffer], x, y, x, y, rect_width, rect_height, &rect == last ? True : False);
+		else
+			XPutImage(display, m_display_ptr->m_window, m_gc, m_images[m_back_buffer], x, y, x, y, rect_width, rect_height);
+	}
+
+	if (m_shm == true)
+		m_shm_tickets[m_back_buffer] = ++m_display_ptr->m_shm_submissions;
+	XFlush(display);
+
+	const std::size_t presented = m_back_buffer;
+	m_back_buffer = (m_back_buffer + 1) % buffer_count;
+
+	// Wait until the server has read the new back buffer, and bring it up to date with the presented frame
+	if (m_shm == true)
+		wait_shm_completion(m_shm_tickets[m_back_buffer]);
+	copy_damage(presented, m_back_buffer, damage);
+	m_display_ptr->acknowledge_resize();
+}
+
+void ndm::SoftwareFramebuffer::wait_shm_completion(const std::uint64_t ticket)
+{
+	// The event thread of a threaded display is the only reader of the connection, it counts the completions and wakes this 
+	// thread. It is woken before each wait, a completion read from the socket by an Xlib call of this thread is then 
+	// still taken from the queue
+	if (m_display_ptr->m_threaded == true)
+	{
+		std::uint64_t completions = m_display_ptr->m_shm_completions.load(std::memory_order_acquire);
+		while (completions < ticket)
+		{
+			m_display_ptr->wake();
+			m_display_ptr->m_shm_completions.wait(completions, std::memory_order_acquire);
+			completions = m_display_ptr->m_shm_completions.load(std::memory_order_acquire);
+		}
+		return;
+	}
+
+	// The other events are kept in the queue for catch_events()
+	XEvent event = {};
+	int completion_type = m_display_ptr->m_shm_completion_type.load(std::memory_order_relaxed);
+	while (m_display_ptr->m_shm_completions.load(std::memory_order_relaxed) < ticket)
+	{
+		XIfEvent(m_display_ptr->m_display, &event, x11_is_shm_completion, reinterpret_cast<XPointer>(&completion_type));
+		ndm::x11_process_events(m_display_ptr, event);
+	}
+}
+
+bool ndm::SoftwareFramebuffer::is_zero_copy() const noexcept
+{
+	return m_loaded == true && m_shm == true;
+}
+
+#endif
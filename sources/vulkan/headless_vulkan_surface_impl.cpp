@@ -0,0 +1,36 @@
+// Only compile on Linux with the headless backend and Vulkan
+#if defined(__linux__) && defined(NDM_HEADLESS) && defined(NDM_ENABLE_VULKAN)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+
+std::vector<const char *> ndm::Display::get_vulkan_instance_extensions()
+{
+	// There is no window system, the headless surface is presented nowhere but has the swapchain of a window
+	return { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+}
+
+VkSurfaceKHR ndm::Display::create_vulkan_surface(VkInstance instance) const
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (instance == VK_NULL_HANDLE)
+		throw std::runtime_error("Can't create a Vulkan surface with a null instance !");
+
+	// The function of an instance extension is not exported by every loader
+	PFN_vkCreateHeadlessSurfaceEXT create_headless_surface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT"));
+	if (create_headless_surface == nullptr)
+		throw std::runtime_error("VK_EXT_headless_surface is not enabled on the instance !");
+
+	VkHeadlessSurfaceCreateInfoEXT create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
+	if (create_headless_surface(instance, &create_info, nullptr, &surface) != VK_SUCCESS)
+		throw std::runtime_error("Can't create the Vulkan surface of the display !");
+
+	return surface;
+}
+
+#endif
@@ -0,0 +1,32 @@
+// Only compile on Windows (x32 or x64) with Vulkan
+#if (defined(_WIN32) || defined(_WIN64)) && defined(NDM_ENABLE_VULKAN)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+
+std::vector<const char *> ndm::Display::get_vulkan_instance_extensions()
+{
+	return { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_WIN32_SURFACE_EXTENSION_NAME };
+}
+
+VkSurfaceKHR ndm::Display::create_vulkan_surface(VkInstance instance) const
+{
+	if (m_loaded == false)
+		throw std::exception("The display is not loaded !");
+
+	if (instance == VK_NULL_HANDLE)
+		throw std::exception("Can't create a Vulkan surface with a null instance !");
+
+	VkWin32SurfaceCreateInfoKHR create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
+	create_info.hinstance = m_instance;
+	create_info.hwnd = m_handle;
+
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
+	if (vkCreateWin32SurfaceKHR(instance, &create_info, nullptr, &surface) != VK_SUCCESS)
+		throw std::exception("Can't create the Vulkan surface of the display !");
+
+	return surface;
+}
+
+#endif
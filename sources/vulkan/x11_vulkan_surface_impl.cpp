@@ -0,0 +1,33 @@
+// Only compile on Linux with Vulkan, the headless build uses its own surface
+#if defined(__linux__) && !defined(NDM_HEADLESS) && defined(NDM_ENABLE_VULKAN)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+
+std::vector<const char *> ndm::Display::get_vulkan_instance_extensions()
+{
+	// The window is created with Xlib, so the surface uses the Xlib connection instead of XCB
+	return { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_XLIB_SURFACE_EXTENSION_NAME };
+}
+
+VkSurfaceKHR ndm::Display::create_vulkan_surface(VkInstance instance) const
+{
+	if (m_loaded == false)
+		throw std::runtime_error("The display is not loaded !");
+
+	if (instance == VK_NULL_HANDLE)
+		throw std::runtime_error("Can't create a Vulkan surface with a null instance !");
+
+	VkXlibSurfaceCreateInfoKHR create_info = {};
+	create_info.sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR;
+	create_info.dpy = m_display;
+	create_info.window = m_window;
+
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
+	if (vkCreateXlibSurfaceKHR(instance, &create_info, nullptr, &surface) != VK_SUCCESS)
+		throw std::runtime_error("Can't create the Vulkan surface of the display !");
+
+	return surface;
+}
+
+#endif
@@ -0,0 +1,117 @@
+// NDM includes
+#include <ndm/display/damage_region.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+// Check if a rectangle is inside of another one
+static bool contains(const ndm::DisplayRect & outer, const ndm::DisplayRect & inner)
+{
+	return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+}
+
+// Check if every rectangle added is covered by a rectangle of the region
+static bool covers(const ndm::DamageRegion & region, const std::vector<ndm::DisplayRect> & added)
+{
+	for (const ndm::DisplayRect & rect : added)
+	{
+		bool covered = false;
+		for (const ndm::DisplayRect & region_rect : region)
+			covered = covered || contains(region_rect, rect);
+
+		if (covered == false)
+			return false;
+	}
+
+	return true;
+}
+
+// Print the result of a check
+static bool check(const char * name, const bool valid)
+{
+	std::cout << name << " : " << (valid ? "valid" : "invalid") << std::endl;
+	return valid;
+}
+
+// Main
+int main()
+{
+	bool valid = true;
+	ndm::DamageRegion region;
+
+	// Empty rectangles are ignored
+	region.add(10, 10, 0, 20);
+	region.add(10, 10, 20, -1);
+	valid = check("empty rectangles", region.empty() == true && region.size() == 0) && valid;
+
+	// Overlapping and touching rectangles are merged, distant ones are kept apart
+	region.clear();
+	region.add(0, 0, 10, 10);
+	region.add(2, 2, 10, 10);
+	const bool overlapping = region.size() == 1 && region.get_area() == 144;
+	region.clear();
+	region.add(0, 0, 10, 10);
+	region.add(10, 0, 10, 10);
+	const bool touching = region.size() == 1 && region.get_area() == 200;
+	region.clear();
+	region.add(0, 0, 10, 10);
+	region.add(100, 100, 10, 10);
+	const bool distant = region.size() == 2 && region.get_area() == 200;
+	valid = check("merge", overlapping && touching && distant) && valid;
+
+	// A rectangle inside of the region doesn't change it
+	region.clear();
+	region.add(0, 0, 100, 100);
+	region.add(10, 10, 5, 5);
+	const ndm::DisplayRect bounds = region.get_bounds();
+	valid = check("contained", region.size() == 1 && bounds.x == 0 && bounds.y == 0 && bounds.width == 100 && bounds.height == 100) && valid;
+
+	// A merged rectangle can reach another rectangle, they are merged too
+	region.clear();
+	region.add(0, 0, 10, 10);
+	region.add(20, 0, 10, 10);
+	const bool apart = region.size() == 2;
+	region.add(10, 0, 10, 10);
+	valid = check("chained merge", apart == true && region.size() == 1 && region.get_area() == 300) && valid;
+
+	// When the region is full, a new rectangle is merged with the rectangle that grows the least
+	region.clear();
+	std::vector<ndm::DisplayRect> added;
+	for (std::size_t i = 0; i < ndm::DamageRegion::capacity; i++)
+	{
+		added.push_back(ndm::DisplayRect { static_cast<std::int64_t>(i) * 100, 0, 10, 10 });
+		region.add(added.back());
+	}
+	const bool full = region.size() == ndm::DamageRegion::capacity && covers(region, added);
+	added.push_back(ndm::DisplayRect { 1515, 0, 10, 10 });
+	region.add(added.back());
+	const std::int64_t overflow_area = static_cast<std::int64_t>(ndm::DamageRegion::capacity - 1) * 100 + 25 * 10;
+	valid = check("capacity overflow", full == true && region.size() == ndm::DamageRegion::capacity && covers(region, added) && region.get_area() == overflow_area) && valid;
+
+	// Many rectangles never exceed the capacity and stay covered
+	region.clear();
+	added.clear();
+	for (std::int64_t i = 0; i < 200; i++)
+	{
+		added.push_back(ndm::DisplayRect { (i * 37) % 1000, (i * 91) % 700, 5 + i % 11, 3 + i % 7 });
+		region.add(added.back());
+	}
+	valid = check("many rectangles", region.size() <= ndm::DamageRegion::capacity && covers(region, added)) && valid;
+
+	// The rectangles are clipped to the surface, a rectangle outside of the surface is empty
+	const ndm::DisplayRect clipped = ndm::DamageRegion::clip(ndm::DisplayRect { -5, -5, 10, 10 }, 8, 8);
+	const ndm::DisplayRect right = ndm::DamageRegion::clip(ndm::DisplayRect { 6, 6, 10, 10 }, 8, 8);
+	const ndm::DisplayRect outside = ndm::DamageRegion::clip(ndm::DisplayRect { 20, 0, 10, 10 }, 8, 8);
+	valid = check("clip", clipped.x == 0 && clipped.y == 0 && clipped.width == 5 && clipped.height == 5 &&
+						  right.x == 6 && right.y == 6 && right.width == 2 && right.height == 2 &&
+						  outside.width <= 0) && valid;
+
+	// Clear
+	region.clear();
+	const ndm::DisplayRect cleared = region.get_bounds();
+	valid = check("clear", region.empty() == true && region.get_area() == 0 && cleared.width == 0 && cleared.height == 0) && valid;
+
+	return valid == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+// NDM includes
+#include <ndm/display/display_events.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+// Check if the events of a ring have the given types and sizes
+static bool matches(const ndm::DisplayEvents & events, const std::vector<ndm::DisplayEventType> & types, const std::vector<std::int64_t> & widths)
+{
+	if (events.size() != types.size())
+		return false;
+
+	std::size_t i = 0;
+	for (const ndm::DisplayEvent & event : events)
+	{
+		if (event.type != types[i] || event.width != widths[i])
+			return false;
+		i++;
+	}
+
+	return true;
+}
+
+// Print the result of a check
+static bool check(const char * name, const bool valid)
+{
+	std::cout << name << " : " << (valid ? "valid" : "invalid") << std::endl;
+	return valid;
+}
+
+// Main
+int main()
+{
+	bool valid = true;
+
+	// A storm of resizes is reported with the last size, the other events keep their order
+	ndm::DisplayEvents storm;
+	storm.push(ndm::DisplayEventType::RESIZED, 0, 0, 100, 100);
+	storm.push(ndm::DisplayEventType::MOVED, 10, 10);
+	storm.push(ndm::DisplayEventType::RESIZED, 0, 0, 200, 150);
+	storm.push(ndm::DisplayEventType::KEY_PRESSED, 0, 0, 0, 0, 30, 0);
+	storm.push(ndm::DisplayEventType::RESIZED, 0, 0, 300, 200);
+	storm.coalesce(ndm::DisplayEventType::RESIZED);
+	valid = check("resize storm", matches(storm, { ndm::DisplayEventType::MOVED, ndm::DisplayEventType::KEY_PRESSED, ndm::DisplayEventType::RESIZED }, { 0, 0, 300 })) && valid;
+
+	// The events after the last resize stay after it
+	ndm::DisplayEvents trailing;
+	trailing.push(ndm::DisplayEventType::RESIZED, 0, 0, 100, 100);
+	trailing.push(ndm::DisplayEventType::RESIZED, 0, 0, 200, 100);
+	trailing.push(ndm::DisplayEventType::MOVED, 10, 10);
+	trailing.coalesce(ndm::DisplayEventType::RESIZED);
+	valid = check("trailing events", matches(trailing, { ndm::DisplayEventType::RESIZED, ndm::DisplayEventType::MOVED }, { 200, 0 })) && valid;
+
+	// Without an event of the type, or with a single one, the ring is unchanged
+	ndm::DisplayEvents unchanged;
+	unchanged.push(ndm::DisplayEventType::MOVED, 10, 10);
+	unchanged.push(ndm::DisplayEventType::FOCUS_LOST);
+	unchanged.coalesce(ndm::DisplayEventType::RESIZED);
+	const bool without = matches(unchanged, { ndm::DisplayEventType::MOVED, ndm::DisplayEventType::FOCUS_LOST }, { 0, 0 });
+	unchanged.push(ndm::DisplayEventType::RESIZED, 0, 0, 100, 100);
+	unchanged.coalesce(ndm::DisplayEventType::RESIZED);
+	const bool single = matches(unchanged, { ndm::DisplayEventType::MOVED, ndm::DisplayEventType::FOCUS_LOST, ndm::DisplayEventType::RESIZED }, { 0, 0, 100 });
+	valid = check("unchanged", without && single) && valid;
+
+	// The coalesced events can wrap around the end of the ring
+	ndm::DisplayEvents wrapped;
+	ndm::DisplayEvent popped = {};
+	for (std::size_t i = 0; i < ndm::DisplayEvents::capacity - 2; i++)
+	{
+		wrapped.push(ndm::DisplayEventType::MOVED);
+		wrapped.pop(popped);
+	}
+	wrapped.push(ndm::DisplayEventType::RESIZED, 0, 0, 100, 100);
+	wrapped.push(ndm::DisplayEventType::MOVED, 10, 10);
+	wrapped.push(ndm::DisplayEventType::RESIZED, 0, 0, 200, 100);
+	wrapped.push(ndm::DisplayEventType::KEY_PRESSED, 0, 0, 0, 0, 30, 0);
+	wrapped.push(ndm::DisplayEventType::RESIZED, 0, 0, 300, 100);
+	wrapped.coalesce(ndm::DisplayEventType::RESIZED);
+	valid = check("wrap around", matches(wrapped, { ndm::DisplayEventType::MOVED, ndm::DisplayEventType::KEY_PRESSED, ndm::DisplayEventType::RESIZED }, { 0, 0, 300 })) && valid;
+
+	// A full ring drops the new events and counts them, coalescing makes room again
+	ndm::DisplayEvents full;
+	for (std::size_t i = 0; i < ndm::DisplayEvents::capacity; i++)
+		full.push(ndm::DisplayEventType::RESIZED, 0, 0, static_cast<std::int64_t>(i), 100);
+	const bool dropped = full.push(ndm::DisplayEventType::MOVED) == false && full.get_dropped_count() == 1;
+	full.coalesce(ndm::DisplayEventType::RESIZED);
+	const bool room = full.size() == 1 && full.push(ndm::DisplayEventType::MOVED) == true;
+	valid = check("full ring", dropped && room) && valid;
+
+	return valid == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,134 @@
+// Only compile on Windows (x32 or x64) or Linux
+#if defined(_WIN32) || defined(_WIN64) || defined(__linux__)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/display/display_manager.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+#include <thread>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// The number of frames to run, the tool window is resized in the middle of the run. Without a count the windows run
+	// until they are closed, nothing closes a headless display and nothing else wakes it up
+	#if defined(NDM_HEADLESS)
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : 120;
+	const bool visible = false;
+	const std::chrono::milliseconds frame_time(1);
+	#else
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : -1;
+	const bool visible = true;
+	const std::chrono::milliseconds frame_time(16);
+	#endif
+
+	try {
+		// Create a main view and a tool window, the events of their creation are not checked
+		ndm::Display main_display;
+		main_display.load("Main view", 900, 600, visible);
+		main_display.catch_events();
+
+		ndm::Display tool_display;
+		tool_display.load("Tool window", 300, 400, visible);
+		tool_display.catch_events();
+
+		const std::int64_t main_width = main_display.get_framebuffer_width();
+		const std::int64_t tool_width = tool_display.get_framebuffer_width();
+
+		// A single loop reads the events of both displays
+		ndm::DisplayManager manager;
+		manager.load();
+		manager.add(&main_display);
+		manager.add(&tool_display);
+
+		// Run
+		long main_resizes = 0;
+		long tool_resizes = 0;
+		std::int64_t tool_resized_width = tool_width;
+		bool valid = true;
+		for (long frame = 0; manager.get_displays().empty() == false && (max_frames < 0 || frame < max_frames); frame++)
+		{
+			if (max_frames >= 0 && frame == max_frames / 2)
+				tool_display.set_geometry(0, 0, 320, 480);
+
+			// Get Events, a frame is at most the frame time like a render loop
+			for (const ndm::DisplayManagerEvent & managed : manager.wait_events(frame_time))
+			{
+				const char * name = managed.display == &main_display ? "main" : "tool";
+				const ndm::DisplayEvent & event = managed.event;
+				switch (event.type)
+				{
+					case ndm::DisplayEventType::RESIZED:
+						std::cout << name << " : resized " << event.width << "x" << event.height << std::endl;
+						if (managed.display == &tool_display)
+						{
+							tool_resizes++;
+							tool_resized_width = event.width;
+						} else {
+							main_resizes++;
+						}
+						break;
+					case ndm::DisplayEventType::MINIMIZED:
+						std::cout << name << " : minimized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MAXIMIZED:
+						std::cout << name << " : maximized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MOVED:
+						std::cout << name << " : moved " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MONITORS_CHANGED:
+						std::cout << name << " : monitors changed" << std::endl;
+						break;
+					case ndm::DisplayEventType::CLOSED:
+						std::cout << name << " : closed" << std::endl;
+						manager.remove(managed.display);
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		// The resize of the tool window is only reported for it, the windows resized by the user are not checked
+		if (max_frames >= 0)
+		{
+			const bool resize_valid = tool_resizes == 1 && main_resizes == 0 && tool_resized_width != tool_width &&
+									  tool_display.get_framebuffer_width() == tool_resized_width && main_display.get_framebuffer_width() == main_width;
+			std::cout << "resize : " << (resize_valid ? "valid" : "invalid") << std::endl;
+			valid = valid && resize_valid;
+		}
+
+		// Another thread wakes up the manager long before the timeout
+		const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		std::thread waker([&manager]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			manager.wake();
+		});
+		manager.wait_events(std::chrono::milliseconds(5000));
+		const std::chrono::milliseconds waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+		waker.join();
+
+		const bool wake_valid = waited < std::chrono::milliseconds(2500);
+		std::cout << "wake : " << waited.count() << " ms " << (wake_valid ? "valid" : "invalid") << std::endl;
+		valid = valid && wake_valid;
+
+		// Unload
+		manager.unload();
+		tool_display.unload();
+		main_display.unload();
+
+		if (valid == false)
+			return EXIT_FAILURE;
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,132 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+
+// STD includes
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <thread>
+
+// GL includes
+#include <GL/gl.h>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// The number of frames to render, the display is resized in the middle of the run
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : 600;
+
+	try {
+		// Create the display
+		ndm::Display display;
+		display.load("Headless display", 640, 480, false);
+
+		// GL Context
+		ndm::GLContext gl_context(&display);
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 8;
+		params.depth_bits = 24;
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+		gl_context.load(params);
+
+		std::cout << glGetString(GL_RENDERER) << " - " << glGetString(GL_VERSION) << std::endl;
+
+		// Run
+		ndm::GLFramebufferImage image = {};
+		ndm::DamageRegion damage;
+		bool valid = true;
+		for (long frame = 0; frame < max_frames; frame++)
+		{
+			if (frame == max_frames / 2)
+				display.set_geometry(0, 0, 320, 240);
+
+			// Get Events
+			for (const ndm::DisplayEvent & event : display.catch_events())
+			{
+				if (event.type == ndm::DisplayEventType::RESIZED)
+					std::cout << "display : resized " << event.width << "x" << event.height << std::endl;
+			}
+
+			// Test OpenGL, the color changes each frame so a stale framebuffer is detected
+			const std::uint8_t red = static_cast<std::uint8_t>(frame % 256);
+			glClearColor(red / 255.0f, 0.5f, 0, 1);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			// Read back the first frame and the first frames after the resize
+			if (frame == 0 || frame == max_frames / 2 + 1)
+			{
+				gl_context.read_framebuffer(image);
+				const bool size_valid = static_cast<std::int64_t>(image.width) == display.get_client_width() && static_cast<std::int64_t>(image.height) == display.get_client_height();
+				const bool color_valid = image.pixels[0] == red && image.pixels[image.pixels.size() - 4] == red;
+				std::cout << "framebuffer " << image.width << "x" << image.height << " : " << (size_valid && color_valid ? "valid" : "invalid") << std::endl;
+				valid = valid && size_valid && color_valid;
+			}
+
+			// The odd frames only present a small widget, like a dashboard that updates a single value
+			if (frame % 2 == 1)
+			{
+				damage.clear();
+				damage.add(16, 16, 64, 32);
+				damage.add(80, 16, 64, 32);
+				gl_context.swap_front_and_back(damage);
+			} else {
+				gl_context.swap_front_and_back();
+			}
+		}
+
+		// An empty damage presents the whole frame, so the surface still follows a resize
+		display.set_geometry(0, 0, 200, 100);
+		display.catch_events();
+		damage.clear();
+		gl_context.swap_front_and_back(damage);
+		gl_context.read_framebuffer(image);
+		const bool empty_damage_valid = image.width == 200 && image.height == 100;
+		std::cout << "empty damage : " << (empty_damage_valid ? "valid" : "invalid") << std::endl;
+		valid = valid && empty_damage_valid;
+
+		// Frame statistics
+		const ndm::GLFrameStatistics & statistics = gl_context.get_frame_statistics();
+		std::cout << "frames: " << statistics.frame_count << std::endl;
+		std::cout << "frame time p50/p95/p99 (us): " << statistics.frame_time_p50.count() / 1000 << " / "
+				  << statistics.frame_time_p95.count() / 1000 << " / " << statistics.frame_time_p99.count() / 1000 << std::endl;
+
+		// Unload
+		gl_context.unload();
+		display.unload();
+
+		// The scopes of the library can be opened in chrome://tracing or Perfetto
+		#if defined(NDM_ENABLE_TRACE)
+		// A thread that ends gives its buffer to the next new thread, short-lived workers don't add a buffer each
+		for (int worker = 0; worker < 16; worker++)
+			std::thread([]() { NDM_TRACE_SCOPE("worker"); }).join();
+		const bool recycled = ndm::Trace::get_buffer_count() == 2;
+		std::cout << "trace buffers : " << ndm::Trace::get_buffer_count() << " " << (recycled ? "valid" : "invalid") << std::endl;
+		valid = valid && recycled;
+
+		std::ofstream trace_file("egl-headless-trace.json");
+		ndm::Trace::export_chrome_trace(trace_file);
+		std::cout << "trace written in egl-headless-trace.json" << std::endl;
+		#endif
+
+		if (valid == false)
+			return EXIT_FAILURE;
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
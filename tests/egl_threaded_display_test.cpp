@@ -0,0 +1,105 @@
+// Only compile on Linux with the headless backend
+#if defined(__linux__) && defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/threaded_display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+
+// STD includes
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+// GL includes
+#include <GL/gl.h>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// The number of frames to render
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : 240;
+
+	try {
+		// The display and its events are handled by the event thread, this thread only renders
+		ndm::ThreadedDisplay display;
+		display.load("Threaded headless display", 640, 480, false);
+
+		// GL Context, it follows the framebuffer size published by catch_events() on this thread
+		ndm::GLContext gl_context(&display.get_display());
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 8;
+		params.depth_bits = 24;
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+		gl_context.load(params);
+
+		std::cout << glGetString(GL_RENDERER) << " - " << glGetString(GL_VERSION) << std::endl;
+
+		// Run, the display is resized by the event thread while this thread renders
+		ndm::GLFramebufferImage image = {};
+		bool valid = true;
+		long resize_count = 0;
+		long checked_count = 0;
+		bool check_framebuffer = true;
+		for (long frame = 0; frame < max_frames; frame++)
+		{
+			if (frame % 8 == 0 && frame + 8 < max_frames)
+				display.set_geometry(0, 0, (frame / 8) % 2 == 0 ? 320 : 640, (frame / 8) % 2 == 0 ? 240 : 480);
+			if (frame % 30 == 0)
+				display.set_title("Threaded headless display - frame " + std::to_string(frame));
+
+			bool resized = false;
+			for (const ndm::DisplayEvent & event : display.catch_events())
+			{
+				if (event.type == ndm::DisplayEventType::RESIZED)
+				{
+					resize_count++;
+					resized = true;
+				}
+			}
+
+			glClearColor(0, 0, 1.0f, 1);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			// The pbuffer follows the size seen by the render thread on the swap, so the frame after a resize has the new size
+			if (check_framebuffer == true && resized == false)
+			{
+				checked_count++;
+				gl_context.read_framebuffer(image);
+				const bool size_valid = static_cast<std::int64_t>(image.width) == display.get_framebuffer_width() && 
+										static_cast<std::int64_t>(image.height) == display.get_framebuffer_height();
+				if (size_valid == false)
+					std::cout << "framebuffer " << image.width << "x" << image.height << " : invalid" << std::endl;
+				valid = valid && size_valid;
+				check_framebuffer = false;
+			}
+
+			gl_context.swap_front_and_back();
+			check_framebuffer = check_framebuffer || resized;
+		}
+
+		std::cout << "resizes: " << resize_count << ", checked frames: " << checked_count << ", framebuffer : " << (valid ? "valid" : "invalid") << std::endl;
+		std::cout << "failed commands: " << display.get_failed_command_count() << std::endl;
+		valid = valid && resize_count > 0 && checked_count > 1 && display.get_failed_command_count() == 0;
+
+		// Unload
+		gl_context.unload();
+		display.unload();
+
+		if (valid == false)
+			return EXIT_FAILURE;
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,69 @@
+// NDM includes
+#include <ndm/opengl/gl_frame_timer.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+
+// Refresh period of a 60 Hz display
+static constexpr std::chrono::nanoseconds period = std::chrono::nanoseconds(1000000000 / 60);
+
+// Print the result of a check
+static bool check(const char * name, const bool valid)
+{
+	std::cout << name << " : " << (valid ? "valid" : "invalid") << std::endl;
+	return valid;
+}
+
+// Main
+int main()
+{
+	bool valid = true;
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	// The swaps with the media stream counter count the retraces really elapsed after the expected one
+	ndm::GLFrameTimer timer;
+	timer.set_refresh_period(period);
+	for (std::int64_t msc = 100; msc < 110; msc++)
+	{
+		now += period;
+		timer.record(now, now, msc);
+	}
+	now += 3 * period;
+	timer.record(now, now, 112);
+	valid = check("media stream counter", timer.get_statistics().missed_intervals == 2 && timer.get_statistics().frame_count == 10 && timer.get_statistics().hardware_timestamps == true) && valid;
+
+	// A copy timed with the CPU clock in the middle doesn't make the next swap count the retraces since the last counter
+	ndm::GLFrameTimer copied;
+	copied.set_refresh_period(period);
+	now += period;
+	copied.record(now, now, 100);
+	for (int i = 0; i < 30; i++)
+	{
+		now += period;
+		copied.record(now, now);
+	}
+	now += period;
+	copied.record(now, now, 131);
+	now += period;
+	copied.record(now, now, 132);
+	valid = check("copy then swap", copied.get_statistics().missed_intervals == 0 && copied.get_statistics().frame_count == 32 && copied.get_statistics().hardware_timestamps == true) && valid;
+
+	// Without the counter, the missed intervals are estimated from the refresh period
+	ndm::GLFrameTimer estimated;
+	estimated.set_refresh_period(period);
+	estimated.set_swap_interval(1);
+	now += period;
+	estimated.record(now, now);
+	now += period;
+	estimated.record(now, now);
+	now += 4 * period;
+	estimated.record(now, now);
+	valid = check("estimated", estimated.get_statistics().missed_intervals == 3 && estimated.get_statistics().hardware_timestamps == false) && valid;
+
+	// Reset clears the statistics but keeps the refresh period
+	estimated.reset();
+	valid = check("reset", estimated.get_statistics().frame_count == 0 && estimated.get_statistics().missed_intervals == 0 && estimated.get_statistics().refresh_period == period) && valid;
+
+	return valid == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
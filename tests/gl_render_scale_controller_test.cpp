@@ -0,0 +1,129 @@
+// NDM includes
+#include <ndm/opengl/gl_render_scale_controller.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+// Frame budget of a 60 Hz display
+static constexpr std::chrono::nanoseconds budget = std::chrono::nanoseconds(1000000000 / 60);
+
+// Record frames with the same frame time, like a context does after each swap
+static void record(ndm::GLRenderScaleController & controller, ndm::GLFrameStatistics & statistics, const double budget_fraction, const std::uint64_t count)
+{
+	for (std::uint64_t i = 0; i < count; i++)
+	{
+		statistics.frame_count++;
+		statistics.last_frame_time = std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(budget.count()) * budget_fraction));
+		controller.update(statistics, 1);
+	}
+}
+
+// Record frames until the scale changes, return the number of frames recorded
+static std::uint64_t record_until_change(ndm::GLRenderScaleController & controller, ndm::GLFrameStatistics & statistics, const double budget_fraction)
+{
+	const double scale = controller.get_scale();
+	std::uint64_t count = 0;
+	while (controller.get_scale() == scale && count < 10000)
+	{
+		record(controller, statistics, budget_fraction, 1);
+		count++;
+	}
+	return count;
+}
+
+// Compare two scales
+static bool equals(const double a, const double b)
+{
+	return std::abs(a - b) < 1e-9;
+}
+
+// Print the result of a check
+static bool check(const char * name, const bool valid)
+{
+	std::cout << name << " : " << (valid ? "valid" : "invalid") << std::endl;
+	return valid;
+}
+
+// Main
+int main()
+{
+	bool valid = true;
+	const std::uint64_t window = ndm::GLRenderScaleController::window_size;
+	const double step = ndm::GLRenderScaleController::upscale_step;
+	ndm::GLFrameStatistics statistics = {};
+
+	// The scale stays at the maximum while the controller is disabled
+	ndm::GLRenderScaleController controller;
+	controller.set_scale_range(0.5, 1.0);
+	controller.set_target_refresh_rate(60);
+	record(controller, statistics, 2.0, 4 * window);
+	valid = check("disabled", equals(controller.get_scale(), 1.0) && controller.get_frame_budget() == budget) && valid;
+
+	// Without a target, the budget follows the refresh period and the swap interval
+	ndm::GLRenderScaleController measured;
+	ndm::GLFrameStatistics measured_statistics = {};
+	measured_statistics.refresh_period = std::chrono::nanoseconds(1000000000 / 144);
+	measured_statistics.frame_count = 1;
+	measured.update(measured_statistics, 2);
+	valid = check("budget", measured.get_frame_budget() == measured_statistics.refresh_period * 2) && valid;
+
+	// Frames over the budget bring the scale down in proportion of the excess, once the window is full
+	controller.set_enabled(true);
+	record(controller, statistics, 1.5, window - 1);
+	const bool waits_window = equals(controller.get_scale(), 1.0);
+	record(controller, statistics, 1.5, 1);
+	const double downscaled = controller.get_scale();
+	valid = check("downscale", waits_window && equals(downscaled, std::sqrt(1.0 / 1.5) * 0.95) && controller.get_render_size(1000) == std::llround(1000 * downscaled)) && valid;
+
+	// Between both thresholds the scale doesn't move, until a higher scale is tried
+	record(controller, statistics, 1.1, ndm::GLRenderScaleController::min_probe_delay - 1);
+	const bool over_budget = equals(controller.get_scale(), downscaled);
+	controller.set_enabled(true);
+	record(controller, statistics, 1.5, window);
+	record(controller, statistics, 0.85, ndm::GLRenderScaleController::min_probe_delay - 1);
+	const bool under_budget = equals(controller.get_scale(), downscaled);
+	valid = check("hysteresis", over_budget && under_budget) && valid;
+
+	// Frames far under the budget bring the scale up by steps, each step waits for a full window
+	controller.set_enabled(true);
+	record(controller, statistics, 1.5, window);
+	const std::uint64_t first_step = record_until_change(controller, statistics, 0.5);
+	const bool stepped = first_step == window && equals(controller.get_scale(), downscaled + step);
+	record(controller, statistics, 0.5, 20 * window);
+	valid = check("upscale", stepped && equals(controller.get_scale(), 1.0)) && valid;
+
+	// With the vertical synchronization the frames take the budget, a higher scale is tried after the probe delay. A failed
+	// try goes back one step and doubles the delay, a successful try halves it
+	controller.set_enabled(true);
+	record(controller, statistics, 1.5, window);
+	const std::uint64_t first_probe = record_until_change(controller, statistics, 1.0);
+	const bool probed = first_probe == ndm::GLRenderScaleController::min_probe_delay && equals(controller.get_scale(), downscaled + step);
+	const std::uint64_t failed_probe = record_until_change(controller, statistics, 1.3);
+	const bool failed = failed_probe == window && equals(controller.get_scale(), downscaled);
+	const std::uint64_t backoff = record_until_change(controller, statistics, 1.0);
+	const bool backed_off = backoff == 2 * ndm::GLRenderScaleController::min_probe_delay && equals(controller.get_scale(), downscaled + step);
+	const std::uint64_t next_probe = record_until_change(controller, statistics, 1.0);
+	const bool succeeded = next_probe == ndm::GLRenderScaleController::min_probe_delay && equals(controller.get_scale(), downscaled + 2 * step);
+	valid = check("probe backoff", probed && failed && backed_off && succeeded) && valid;
+
+	// The failed tries never wait more than the maximum delay
+	std::uint64_t delay = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		delay = record_until_change(controller, statistics, 1.0);
+		record_until_change(controller, statistics, 1.3);
+	}
+	valid = check("max probe delay", delay == ndm::GLRenderScaleController::max_probe_delay) && valid;
+
+	// The scale stays in its range, and the render size is never less than one pixel
+	controller.set_scale_range(0.25, 0.75);
+	const bool clamped = equals(controller.get_scale(), 0.75);
+	record(controller, statistics, 100.0, 10 * window);
+	const bool minimum = equals(controller.get_scale(), 0.25) && controller.get_render_size(2) == 1 && controller.get_render_size(0) == 0;
+	controller.reset();
+	valid = check("range", clamped && minimum && equals(controller.get_scale(), 0.75)) && valid;
+
+	return valid == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
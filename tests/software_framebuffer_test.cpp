@@ -0,0 +1,119 @@
+// Only compile on Windows (x32 or x64) or Linux
+#if defined(_WIN32) || defined(_WIN64) || defined(__linux__)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/software/software_framebuffer.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// The number of frames to draw, the display is resized in the middle of the run. Without a count a window runs until
+	// it is closed, nothing closes a headless display
+	#if defined(NDM_HEADLESS)
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : 600;
+	const bool visible = false;
+	#else
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : -1;
+	const bool visible = true;
+	#endif
+
+	try {
+		// Create the display
+		ndm::Display display;
+		display.load("Software framebuffer", 640, 480, visible);
+
+		// Software framebuffer
+		ndm::SoftwareFramebuffer framebuffer(&display);
+		framebuffer.load();
+		std::cout << "zero copy : " << std::boolalpha << framebuffer.is_zero_copy() << std::endl;
+
+		// Run
+		ndm::DamageRegion damage;
+		bool running = true;
+		bool valid = true;
+		long frame = 0;
+		for (; max_frames < 0 || frame < max_frames; frame++)
+		{
+			if (max_frames >= 0 && frame == max_frames / 2)
+				display.set_geometry(0, 0, 320, 240);
+
+			// Get Events
+			for (const ndm::DisplayEvent & event : display.catch_events())
+			{
+				if (event.type == ndm::DisplayEventType::CLOSED)
+				{
+					running = false;
+					std::cout << "display : closed" << std::endl;
+				}
+
+				if (event.type != ndm::DisplayEventType::RESIZED)
+					continue;
+
+				framebuffer.resize(static_cast<std::uint64_t>(event.width), static_cast<std::uint64_t>(event.height));
+				const bool size_valid = static_cast<std::int64_t>(framebuffer.get_width()) == display.get_framebuffer_width() &&
+										static_cast<std::int64_t>(framebuffer.get_height()) == display.get_framebuffer_height();
+				std::cout << "display : resized " << event.width << "x" << event.height << " " << (size_valid ? "valid" : "invalid") << std::endl;
+				valid = valid && size_valid;
+			}
+
+			if (running == false)
+				break;
+
+			// The even frames draw the whole buffer, and so do the frames of a window too small for the widget
+			const std::uint32_t color = static_cast<std::uint32_t>(frame & 0xFF) << 16 | 0xFF000000;
+			if (frame % 2 == 0 || framebuffer.get_width() < 80 || framebuffer.get_height() < 48)
+			{
+				std::uint8_t * row = reinterpret_cast<std::uint8_t *>(framebuffer.get_pixels());
+				for (std::uint64_t y = 0; y < framebuffer.get_height(); y++, row += framebuffer.get_stride())
+				{
+					std::uint32_t * pixels = reinterpret_cast<std::uint32_t *>(row);
+					for (std::uint64_t x = 0; x < framebuffer.get_width(); x++)
+						pixels[x] = color;
+				}
+
+				framebuffer.present();
+				continue;
+			}
+
+			// The odd frames only update a small widget, the new back buffer must receive it from the presented buffer
+			damage.clear();
+			damage.add(16, 16, 64, 32);
+			std::uint8_t * row = reinterpret_cast<std::uint8_t *>(framebuffer.get_pixels()) + 16 * framebuffer.get_stride();
+			for (std::uint64_t y = 16; y < 48; y++, row += framebuffer.get_stride())
+			{
+				std::uint32_t * pixels = reinterpret_cast<std::uint32_t *>(row);
+				for (std::uint64_t x = 16; x < 80; x++)
+					pixels[x] = color;
+			}
+
+			framebuffer.present(damage);
+			const std::uint32_t * back = framebuffer.get_pixels();
+			const bool damage_valid = back[16 * framebuffer.get_stride() / sizeof(std::uint32_t) + 16] == color &&
+									  back[47 * framebuffer.get_stride() / sizeof(std::uint32_t) + 79] == color;
+			if (damage_valid == false)
+				std::cout << "frame " << frame << " : damage not copied to the back buffer" << std::endl;
+			valid = valid && damage_valid;
+		}
+
+		std::cout << "frames: " << frame << ", framebuffer " << framebuffer.get_width() << "x" << framebuffer.get_height() << " : " << (valid ? "valid" : "invalid") << std::endl;
+
+		// Unload
+		framebuffer.unload();
+		display.unload();
+
+		if (valid == false)
+			return EXIT_FAILURE;
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,122 @@
+// Only compile on Windows (x32 or x64) or Linux with Vulkan
+#if (defined(_WIN32) || defined(_WIN64) || defined(__linux__)) && defined(NDM_ENABLE_VULKAN)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+// Name of a present mode
+static const char * get_present_mode_name(const VkPresentModeKHR mode)
+{
+	switch (mode)
+	{
+		case VK_PRESENT_MODE_IMMEDIATE_KHR:
+			return "IMMEDIATE";
+		case VK_PRESENT_MODE_MAILBOX_KHR:
+			return "MAILBOX";
+		case VK_PRESENT_MODE_FIFO_KHR:
+			return "FIFO";
+		case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+			return "FIFO_RELAXED";
+		default:
+			return "OTHER";
+	}
+}
+
+// Main
+int main()
+{
+	VkInstance instance = VK_NULL_HANDLE;
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
+	bool presentable = false;
+
+	try {
+		// Create the display, a headless surface is presented nowhere but has the swapchain of a window
+		ndm::Display display;
+		#if defined(NDM_HEADLESS)
+		display.load("Headless Vulkan display", 640, 480, false);
+		#else
+		display.load("Vulkan window", 640, 480, true);
+		#endif
+
+		// The instance enables the extensions needed by the surface of the display
+		const std::vector<const char *> extensions = ndm::Display::get_vulkan_instance_extensions();
+		for (const char * extension : extensions)
+			std::cout << "instance extension: " << extension << std::endl;
+
+		VkApplicationInfo application_info = {};
+		application_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		application_info.pApplicationName = "vulkan-test";
+		application_info.apiVersion = VK_API_VERSION_1_0;
+
+		VkInstanceCreateInfo instance_info = {};
+		instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		instance_info.pApplicationInfo = &application_info;
+		instance_info.enabledExtensionCount = static_cast<std::uint32_t>(extensions.size());
+		instance_info.ppEnabledExtensionNames = extensions.data();
+		if (vkCreateInstance(&instance_info, nullptr, &instance) != VK_SUCCESS)
+			throw std::runtime_error("Can't create the Vulkan instance !");
+
+		surface = display.create_vulkan_surface(instance);
+
+		// Find the devices that can present on the surface
+		std::uint32_t device_count = 0;
+		vkEnumeratePhysicalDevices(instance, &device_count, nullptr);
+		std::vector<VkPhysicalDevice> devices(device_count);
+		vkEnumeratePhysicalDevices(instance, &device_count, devices.data());
+
+		for (VkPhysicalDevice device : devices)
+		{
+			VkPhysicalDeviceProperties properties = {};
+			vkGetPhysicalDeviceProperties(device, &properties);
+
+			std::uint32_t family_count = 0;
+			vkGetPhysicalDeviceQueueFamilyProperties(device, &family_count, nullptr);
+			bool supported = false;
+			for (std::uint32_t family = 0; family < family_count && supported == false; family++)
+			{
+				VkBool32 present = VK_FALSE;
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, family, surface, &present);
+				supported = present == VK_TRUE;
+			}
+
+			std::cout << "device: " << properties.deviceName << ", present: " << supported << std::endl;
+			if (supported == false)
+				continue;
+
+			VkSurfaceCapabilitiesKHR capabilities = {};
+			vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &capabilities);
+			std::cout << "surface: " << capabilities.currentExtent.width << "x" << capabilities.currentExtent.height << std::endl;
+			std::cout << "present mode: " << get_present_mode_name(ndm::vulkan_choose_present_mode(device, surface)) << std::endl;
+			presentable = true;
+		}
+
+		// Unload
+		vkDestroySurfaceKHR(instance, surface, nullptr);
+		vkDestroyInstance(instance, nullptr);
+		display.unload();
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		if (instance != VK_NULL_HANDLE)
+		{
+			if (surface != VK_NULL_HANDLE)
+				vkDestroySurfaceKHR(instance, surface, nullptr);
+			vkDestroyInstance(instance, nullptr);
+		}
+		return EXIT_FAILURE;
+	}
+
+	if (presentable == false)
+	{
+		std::cerr << "No device can present on the surface !" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
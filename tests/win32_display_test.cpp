@@ -8,6 +8,7 @@
 
 // STD includes
 #include <iostream>
+#include <cstdlib>
 
 // GL includes
 #include <gl/GL.h>
@@ -37,37 +38,98 @@ int main()
 		gl_context.set_vertical_sync(true);
 
 		std::cout << glGetString(GL_VERSION) << std::endl;
+		std::cout << "content scale : " << display.get_content_scale() << ", framebuffer " << display.get_framebuffer_width() << "x" << display.get_framebuffer_height() << std::endl;
 		glClearColor(1.0f, 0, 0, 1);
 
+		// The dynamic resolution keeps up with the refresh rate of the monitor under the display
+		for (const ndm::Monitor & monitor : ndm::Monitor::get_all_monitors())
+		{
+			const std::int64_t x = static_cast<std::int64_t>(std::get<0>(monitor.get_min_position()));
+			const std::int64_t y = static_cast<std::int64_t>(std::get<1>(monitor.get_min_position()));
+			const std::int64_t width = static_cast<std::int64_t>(std::get<0>(monitor.get_max_size()));
+			const std::int64_t height = static_cast<std::int64_t>(std::get<1>(monitor.get_max_size()));
+			if (display.get_x() >= x && display.get_x() < x + width && display.get_y() >= y && display.get_y() < y + height)
+				gl_context.get_render_scale_controller().set_target_refresh_rate(monitor.get_max_refresh_rate());
+		}
+		std::cout << "frame budget (us): " << gl_context.get_frame_budget().count() / 1000 << std::endl;
+
 		// Run
 		bool running = true;
+		std::uint64_t raw_motion_count = 0;
+		std::int64_t raw_distance = 0;
 		while (running == true)
 		{
 			// Get Events
-			const ndm::DisplayEvents events = display.catch_events();
-
-			// Check some events
-			if (events.resized == true) 
-				std::cout << "display : resized" << std::endl;
-			if (events.minimized == true) 
-				std::cout << "display : minimized" << std::endl;
-			if (events.maximized == true) 
-				std::cout << "display : maximized" << std::endl;
-			if (events.moved == true) 
-				std::cout << "display : moved" << std::endl;
-
-			// Check window closed
-			if (events.closed == true)
+			for (const ndm::DisplayEvent & event : display.catch_events())
 			{
-				running = false;
-				std::cout << "display : closed" << std::endl;
+				switch (event.type)
+				{
+					case ndm::DisplayEventType::RESIZED:
+						std::cout << "display : resized " << event.width << "x" << event.height << std::endl;
+						break;
+					case ndm::DisplayEventType::MINIMIZED:
+						std::cout << "display : minimized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MAXIMIZED:
+						std::cout << "display : maximized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MOVED:
+						std::cout << "display : moved " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MONITORS_CHANGED:
+						std::cout << "display : monitors changed" << std::endl;
+						break;
+					case ndm::DisplayEventType::SCALE_CHANGED:
+						std::cout << "display : scale changed to " << event.x << " dpi, framebuffer " << event.width << "x" << event.height << std::endl;
+						break;
+					case ndm::DisplayEventType::FOCUS_GAINED:
+					case ndm::DisplayEventType::FOCUS_LOST:
+						std::cout << "display : focus " << (event.type == ndm::DisplayEventType::FOCUS_GAINED ? "gained" : "lost") << std::endl;
+						break;
+					case ndm::DisplayEventType::KEY_PRESSED:
+					case ndm::DisplayEventType::KEY_RELEASED:
+						std::cout << "display : key " << (event.type == ndm::DisplayEventType::KEY_PRESSED ? "pressed " : "released ") 
+								  << event.scan_code << " / " << event.key << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_BUTTON_PRESSED:
+					case ndm::DisplayEventType::MOUSE_BUTTON_RELEASED:
+						std::cout << "display : button " << event.key << (event.type == ndm::DisplayEventType::MOUSE_BUTTON_PRESSED ? " pressed at " : " released at ") 
+								  << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_WHEEL:
+						std::cout << "display : wheel " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_MOVED:
+						break;
+					case ndm::DisplayEventType::MOUSE_RAW_MOTION:
+						raw_motion_count++;
+						break;
+					case ndm::DisplayEventType::CLOSED:
+						running = false;
+						std::cout << "display : closed" << std::endl;
+						break;
+				}
 			}
 
+			// Poll the input state, the escape key (scan code 0x01) stops the test
+			const ndm::InputState input = display.get_input_state();
+			raw_distance += std::abs(input.get_mouse_delta_x()) + std::abs(input.get_mouse_delta_y());
+			if (input.was_key_pressed(0x01) == true)
+				running = false;
+
 			// Test OpenGL
 			glClear(GL_COLOR_BUFFER_BIT);
 			gl_context.swap_front_and_back();
 		}
 
+		// Frame statistics
+		const ndm::GLFrameStatistics & statistics = gl_context.get_frame_statistics();
+		std::cout << "frames: " << statistics.frame_count << std::endl;
+		std::cout << "frame time p50/p95/p99 (us): " << statistics.frame_time_p50.count() / 1000 << " / " 
+				  << statistics.frame_time_p95.count() / 1000 << " / " << statistics.frame_time_p99.count() / 1000 << std::endl;
+		std::cout << "missed intervals: " << statistics.missed_intervals << std::endl;
+		std::cout << "raw mouse motions: " << raw_motion_count << " (" << raw_distance << " units)" << std::endl;
+
 		// Unload
 		gl_context.unload();
 		display.unload();
@@ -3,6 +3,7 @@
 
 // NDM includes
 #include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_registry.hpp>
 
 // STD includes
 #include <iostream>
@@ -25,9 +26,22 @@ int main()
 		std::cout << "min refresh rate: " << monitors[i].get_min_refresh_rate() << std::endl;
 		std::cout << "max refresh rate: " << monitors[i].get_max_refresh_rate() << std::endl;
 		std::cout << "primary: " << monitors[i].is_primary() << std::endl;
+		std::cout << "modes: " << monitors[i].get_modes().size() << " (" << monitors[i].get_modes().get_resolution_count() << " resolutions)" << std::endl;
+
+		const ndm::MonitorCapabilities closest = monitors[i].get_closest_capabilities(1920, 1080, 144);
+		std::cout << "closest to 1920x1080@144: " << closest.m_width << "x" << closest.m_height << "@" << closest.refresh_rate << std::endl;
 	}
 	std::cout << "==================" << std::endl;
 
+	// A second refresh of a registry doesn't enumerate the modes again and keeps the generation if nothing changed
+	ndm::MonitorRegistry registry;
+	registry.refresh();
+	const std::uint64_t generation = registry.get_generation();
+	const bool changed = registry.refresh();
+	std::cout << "registry: " << registry.get_handles().size() << " monitor(s), generation " << generation << ", changed on refresh: " << changed << std::endl;
+	for(const ndm::MonitorHandle handle : registry.get_handles())
+		std::cout << "handle " << handle.index << "/" << handle.generation << ": " << registry.get_monitor(handle).get_name() << std::endl;
+
 	return EXIT_SUCCESS;
 }
 
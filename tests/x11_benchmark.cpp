@@ -0,0 +1,269 @@
+// Only compile on Linux
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+#include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_registry.hpp>
+
+// STD includes
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+
+// GL includes
+#include <GL/gl.h>
+
+// The samples of a benchmark in nanoseconds, a sample is the mean time of a batch of calls
+struct BenchmarkResult
+{
+	std::string name;
+	std::vector<std::int64_t> samples;
+	std::size_t batch = 1;
+};
+
+// Keep a value the compiler could otherwise remove with the code computing it
+template <typename Value>
+static inline void do_not_optimize(const Value & value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Time of a function in nanoseconds
+template <typename Function>
+static std::int64_t measure(Function && function)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	function();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run a function several times, each call is a sample
+template <typename Function>
+static BenchmarkResult run(const std::string & name, const std::size_t iterations, Function && function)
+{
+	BenchmarkResult result { name, {} };
+	result.samples.reserve(iterations);
+	for (std::size_t i = 0; i < iterations; i++)
+		result.samples.push_back(measure(function));
+	return result;
+}
+
+// Run a function several times, each sample is the mean time of a batch of calls so the clock doesn't hide a short call
+template <typename Function>
+static BenchmarkResult run_batch(const std::string & name, const std::size_t iterations, const std::size_t batch, Function && function)
+{
+	BenchmarkResult result { name, {}, batch };
+	result.samples.reserve(iterations);
+	for (std::size_t i = 0; i < iterations; i++)
+	{
+		result.samples.push_back(measure([&function, batch] {
+			for (std::size_t call = 0; call < batch; call++)
+				function();
+		}) / static_cast<std::int64_t>(batch));
+	}
+	return result;
+}
+
+// Queue synthetic motion events on the connection of the display, they are processed like the events of the server
+static void queue_motion_events(ndm::Display & display, const std::size_t count)
+{
+	::Display * x11_display = display.get_x11_display();
+	XEvent event = {};
+	event.xmotion.type = MotionNotify;
+	event.xmotion.display = x11_display;
+	event.xmotion.window = display.get_x11_window();
+	event.xmotion.same_screen = True;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		event.xmotion.x = static_cast<int>(i % 256);
+		event.xmotion.y = static_cast<int>(i / 256);
+		XSendEvent(x11_display, display.get_x11_window(), False, PointerMotionMask, &event);
+	}
+
+	// The events sent before the reply of the round trip are read in the queue of Xlib
+	XSync(x11_display, False);
+}
+
+// Value of a sorted sample list at a percentile
+static std::int64_t percentile(const std::vector<std::int64_t> & sorted, const double ratio)
+{
+	if (sorted.empty() == true)
+		return 0;
+	return sorted[static_cast<std::size_t>(ratio * static_cast<double>(sorted.size() - 1) + 0.5)];
+}
+
+// Escape a string for JSON
+static std::string escape(const std::string & value)
+{
+	std::string result;
+	for (const char c : value)
+	{
+		if (c == '"' || c == '\\')
+			result.push_back('\\');
+		if (static_cast<unsigned char>(c) >= 0x20)
+			result.push_back(c);
+	}
+	return result;
+}
+
+// Write the results as JSON, the durations are in nanoseconds
+static void write_json(std::ostream & stream, const std::string & renderer, const std::vector<BenchmarkResult> & results)
+{
+	stream << "{\n";
+	stream << "  \"platform\": \"x11\",\n";
+	stream << "  \"renderer\": \"" << escape(renderer) << "\",\n";
+	stream << "  \"unit\": \"ns\",\n";
+	stream << "  \"benchmarks\": [\n";
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		std::vector<std::int64_t> sorted = results[i].samples;
+		std::sort(sorted.begin(), sorted.end());
+		const std::int64_t total = std::accumulate(sorted.begin(), sorted.end(), std::int64_t(0));
+		const std::int64_t mean = sorted.empty() == true ? 0 : total / static_cast<std::int64_t>(sorted.size());
+
+		stream << "    { \"name\": \"" << escape(results[i].name) << "\", \"iterations\": " << sorted.size() << ", \"batch\": " << results[i].batch
+			   << ", \"min\": " << (sorted.empty() == true ? 0 : sorted.front()) << ", \"mean\": " << mean
+			   << ", \"p50\": " << percentile(sorted, 0.50) << ", \"p95\": " << percentile(sorted, 0.95)
+			   << ", \"p99\": " << percentile(sorted, 0.99) << ", \"max\": " << (sorted.empty() == true ? 0 : sorted.back()) << " }"
+			   << (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	stream << "  ]\n";
+	stream << "}\n";
+}
+
+// Main
+int main(int argc, char ** argv)
+{
+	// The results are written in the given file, or on the standard output
+	const char * output_path = argc > 1 ? argv[1] : nullptr;
+
+	try {
+		std::vector<BenchmarkResult> results;
+		std::string renderer;
+
+		// Monitors
+		results.push_back(run("monitor_enumeration", 20, [] {
+			std::vector<ndm::Monitor> monitors = ndm::Monitor::get_all_monitors();
+		}));
+
+		ndm::MonitorRegistry registry;
+		registry.refresh();
+		results.push_back(run("monitor_registry_refresh", 100, [&registry] {
+			registry.refresh();
+		}));
+
+		// Create the display
+		ndm::Display display;
+		display.load("Benchmark", 640, 480, true);
+		display.catch_events();
+
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 0;
+		params.depth_bits = 24;
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+
+		// Context creation and destruction
+		BenchmarkResult context_load { "gl_context_load", {} };
+		BenchmarkResult context_unload { "gl_context_unload", {} };
+		for (std::size_t i = 0; i < 10; i++)
+		{
+			ndm::GLContext gl_context(&display);
+			context_load.samples.push_back(measure([&] { gl_context.load(params); }));
+			context_unload.samples.push_back(measure([&] { gl_context.unload(); }));
+		}
+		results.push_back(context_load);
+		results.push_back(context_unload);
+
+		// Events, the queued events are processed and pushed in the ring by catch_events()
+		for (const std::size_t count : { std::size_t(0), std::size_t(10), std::size_t(1000) })
+		{
+			BenchmarkResult events { "catch_events_" + std::to_string(count), {} };
+			for (std::size_t i = 0; i < 200; i++)
+			{
+				queue_motion_events(display, count);
+				events.samples.push_back(measure([&display] { display.catch_events(); }));
+			}
+			results.push_back(events);
+		}
+
+		// Geometry, the getters read the cache and a change is confirmed by the server with a configure event
+		results.push_back(run_batch("geometry_get", 1000, 1000, [&display] {
+			do_not_optimize(display.get_x() + display.get_y() + display.get_client_width() + display.get_client_height());
+		}));
+
+		BenchmarkResult geometry_set { "geometry_set", {} };
+		BenchmarkResult geometry_round_trip { "geometry_set_round_trip", {} };
+		for (std::size_t i = 0; i < 50; i++)
+		{
+			const std::uint64_t width = i % 2 == 0 ? 800 : 640;
+			const std::uint64_t height = i % 2 == 0 ? 600 : 480;
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			geometry_set.samples.push_back(measure([&] { display.set_geometry(display.get_x(), display.get_y(), width, height); }));
+
+			// Wait for the confirmation, a server that ignores the request doesn't block the benchmark
+			bool confirmed = false;
+			while (confirmed == false && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+				for (const ndm::DisplayEvent & event : display.wait_events(std::chrono::milliseconds(100)))
+					if (event.type == ndm::DisplayEventType::RESIZED)
+						confirmed = true;
+			if (confirmed == true)
+				geometry_round_trip.samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+		results.push_back(geometry_set);
+		results.push_back(geometry_round_trip);
+
+		// Swap, without vertical synchronization so the time is the cost of the presentation
+		ndm::GLContext gl_context(&display);
+		gl_context.load(params);
+		if (gl_context.get_swap_control().swap_interval == true)
+			gl_context.set_vertical_sync(false);
+		renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+		glClearColor(0, 0, 1.0f, 1);
+
+		BenchmarkResult swap { "swap_front_and_back", {} };
+		for (std::size_t i = 0; i < 300; i++)
+		{
+			display.catch_events();
+			glClear(GL_COLOR_BUFFER_BIT);
+			swap.samples.push_back(measure([&gl_context] { gl_context.swap_front_and_back(); }));
+		}
+		results.push_back(swap);
+
+		// Unload
+		gl_context.unload();
+		display.unload();
+
+		// Results
+		if (output_path != nullptr)
+		{
+			std::ofstream file(output_path);
+			if (file.is_open() == false)
+				throw std::runtime_error("Can't open the output file !");
+			write_json(file, renderer, results);
+			std::cerr << "results written in " << output_path << std::endl;
+		} else {
+			write_json(std::cout, renderer, results);
+		}
+	} catch (const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
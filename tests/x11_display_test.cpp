@@ -0,0 +1,140 @@
+// Only compile on Linux
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+
+// STD includes
+#include <iostream>
+#include <cstdlib>
+
+// GL includes
+#include <GL/gl.h>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// An optional frame count allows to run the test without user interaction (e.g. under Xvfb)
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : -1;
+
+	try {
+		// Create the display
+		ndm::Display display;
+		display.load("Classic window", 900, 600, true);
+
+		// GL Context
+		ndm::GLContext gl_context(&display);
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 0;
+		params.depth_bits = 24; 
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+		gl_context.load(params);
+		if (gl_context.get_swap_control().swap_interval == true)
+			gl_context.set_vertical_sync(true);
+
+		std::cout << glGetString(GL_VERSION) << std::endl;
+		std::cout << "content scale : " << display.get_content_scale() << ", framebuffer " << display.get_framebuffer_width() << "x" << display.get_framebuffer_height() << std::endl;
+		glClearColor(1.0f, 0, 0, 1);
+
+		// Run
+		bool running = true;
+		long frame = 0;
+		std::uint64_t raw_motion_count = 0;
+		std::int64_t raw_distance = 0;
+		while (running == true)
+		{
+			// Get Events
+			for (const ndm::DisplayEvent & event : display.catch_events())
+			{
+				switch (event.type)
+				{
+					case ndm::DisplayEventType::RESIZED:
+						std::cout << "display : resized " << event.width << "x" << event.height << std::endl;
+						break;
+					case ndm::DisplayEventType::MINIMIZED:
+						std::cout << "display : minimized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MAXIMIZED:
+						std::cout << "display : maximized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MOVED:
+						std::cout << "display : moved " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MONITORS_CHANGED:
+						std::cout << "display : monitors changed" << std::endl;
+						break;
+					case ndm::DisplayEventType::SCALE_CHANGED:
+						std::cout << "display : scale changed to " << event.x << " dpi, framebuffer " << event.width << "x" << event.height << std::endl;
+						break;
+					case ndm::DisplayEventType::FOCUS_GAINED:
+					case ndm::DisplayEventType::FOCUS_LOST:
+						std::cout << "display : focus " << (event.type == ndm::DisplayEventType::FOCUS_GAINED ? "gained" : "lost") << std::endl;
+						break;
+					case ndm::DisplayEventType::KEY_PRESSED:
+					case ndm::DisplayEventType::KEY_RELEASED:
+						std::cout << "display : key " << (event.type == ndm::DisplayEventType::KEY_PRESSED ? "pressed " : "released ") 
+								  << event.scan_code << " / " << event.key << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_BUTTON_PRESSED:
+					case ndm::DisplayEventType::MOUSE_BUTTON_RELEASED:
+						std::cout << "display : button " << event.key << (event.type == ndm::DisplayEventType::MOUSE_BUTTON_PRESSED ? " pressed at " : " released at ") 
+								  << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_WHEEL:
+						std::cout << "display : wheel " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MOUSE_MOVED:
+						break;
+					case ndm::DisplayEventType::MOUSE_RAW_MOTION:
+						raw_motion_count++;
+						break;
+					case ndm::DisplayEventType::CLOSED:
+						running = false;
+						std::cout << "display : closed" << std::endl;
+						break;
+				}
+			}
+
+			// Poll the input state, the escape key (scan code 9) stops the test
+			const ndm::InputState input = display.get_input_state();
+			raw_distance += std::abs(input.get_mouse_delta_x()) + std::abs(input.get_mouse_delta_y());
+			if (input.was_key_pressed(9) == true)
+				running = false;
+
+			// Test OpenGL
+			glClear(GL_COLOR_BUFFER_BIT);
+			gl_context.swap_front_and_back();
+
+			// Stop after the requested number of frames
+			if (max_frames >= 0 && ++frame >= max_frames)
+				running = false;
+		}
+
+		// Frame statistics
+		const ndm::GLFrameStatistics & statistics = gl_context.get_frame_statistics();
+		std::cout << "frames: " << statistics.frame_count << std::endl;
+		std::cout << "frame time p50/p95/p99 (us): " << statistics.frame_time_p50.count() / 1000 << " / " 
+				  << statistics.frame_time_p95.count() / 1000 << " / " << statistics.frame_time_p99.count() / 1000 << std::endl;
+		std::cout << "missed intervals: " << statistics.missed_intervals << std::endl;
+		std::cout << "raw mouse motions: " << raw_motion_count << " (" << raw_distance << " units)" << std::endl;
+
+		// Unload
+		gl_context.unload();
+		display.unload();
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Only compile on Linux
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/monitor/monitor.hpp>
+#include <ndm/monitor/monitor_registry.hpp>
+
+// STD includes
+#include <iostream>
+
+// Main
+int main()
+{
+	// Retrieve all monitors
+	std::vector<ndm::Monitor> monitors = ndm::Monitor::get_all_monitors();
+
+	// Show info of all monitors
+	std::cout << monitors.size() << " monitor(s) founded" << std::endl;
+	for(size_t i = 0; i < monitors.size(); i++)
+	{
+		std::cout << "==================" << std::endl;
+		std::cout << "Monitor " << i << std::endl;
+		std::cout << "name: " << monitors[i].get_name() << std::endl;
+		std::cout << "min size: " << std::get<0>(monitors[i].get_min_size()) << "x" << std::get<1>(monitors[i].get_min_size()) << std::endl;
+		std::cout << "max size: " << std::get<0>(monitors[i].get_max_size()) << "x" << std::get<1>(monitors[i].get_max_size()) << std::endl;
+		std::cout << "min refresh rate: " << monitors[i].get_min_refresh_rate() << std::endl;
+		std::cout << "max refresh rate: " << monitors[i].get_max_refresh_rate() << std::endl;
+		std::cout << "primary: " << monitors[i].is_primary() << std::endl;
+		std::cout << "modes: " << monitors[i].get_modes().size() << " (" << monitors[i].get_modes().get_resolution_count() << " resolutions)" << std::endl;
+
+		const ndm::MonitorCapabilities closest = monitors[i].get_closest_capabilities(1920, 1080, 144);
+		std::cout << "closest to 1920x1080@144: " << closest.m_width << "x" << closest.m_height << "@" << closest.refresh_rate << std::endl;
+	}
+	std::cout << "==================" << std::endl;
+
+	// A second refresh of a registry doesn't enumerate the modes again and keeps the generation if nothing changed
+	ndm::MonitorRegistry registry;
+	registry.refresh();
+	const std::uint64_t generation = registry.get_generation();
+	const bool changed = registry.refresh();
+	std::cout << "registry: " << registry.get_handles().size() << " monitor(s), generation " << generation << ", changed on refresh: " << changed << std::endl;
+	for(const ndm::MonitorHandle handle : registry.get_handles())
+		std::cout << "handle " << handle.index << "/" << handle.generation << ": " << registry.get_monitor(handle).get_name() << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Only compile on Linux
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+
+// STD includes
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <array>
+#include <memory>
+
+// GL includes
+#include <GL/gl.h>
+
+// Main
+int main()
+{
+	constexpr std::size_t worker_count = 4;
+	constexpr GLsizei texture_size = 256;
+
+	try {
+		// Create the display
+		ndm::Display display;
+		display.load("Shared contexts", 640, 480, true);
+
+		// Main GL context
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 0;
+		params.depth_bits = 24;
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+
+		ndm::GLContext gl_context(&display);
+		gl_context.load(params);
+
+		// Each worker uploads a texture in a headless context that shares the objects of the main context
+		std::array<GLuint, worker_count> textures = {};
+		std::vector<std::unique_ptr<ndm::GLContext>> worker_contexts;
+		ndm::GLContextParams worker_params = params;
+		worker_params.shared_context = &gl_context;
+
+		// The worker contexts are created here, the creation of a context is not meant to be concurrent
+		gl_context.release_current();
+		for (std::size_t i = 0; i < worker_count; i++)
+		{
+			worker_contexts.push_back(std::make_unique<ndm::GLContext>());
+			worker_contexts.back()->load(worker_params);
+			worker_contexts.back()->release_current();
+		}
+
+		std::vector<std::thread> workers;
+		for (std::size_t i = 0; i < worker_count; i++)
+		{
+			workers.emplace_back([&, i]()
+			{
+				worker_contexts[i]->make_current();
+
+				std::vector<unsigned char> pixels(texture_size * texture_size * 4, static_cast<unsigned char>(i * 60));
+				glGenTextures(1, &textures[i]);
+				glBindTexture(GL_TEXTURE_2D, textures[i]);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texture_size, texture_size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+				glBindTexture(GL_TEXTURE_2D, 0);
+
+				// The upload must be complete before the main context uses the texture
+				glFinish();
+				worker_contexts[i]->release_current();
+			});
+		}
+
+		for (std::thread & worker : workers)
+			worker.join();
+
+		// The textures of the workers are visible from the main context
+		gl_context.make_current();
+		bool shared = true;
+		for (std::size_t i = 0; i < worker_count; i++)
+		{
+			const bool is_texture = glIsTexture(textures[i]) == GL_TRUE;
+			std::cout << "Texture " << textures[i] << " of worker " << i << " is shared : " << std::boolalpha << is_texture << std::endl;
+			shared = shared && is_texture;
+		}
+
+		glDeleteTextures(worker_count, textures.data());
+
+		for (std::unique_ptr<ndm::GLContext> & worker_context : worker_contexts)
+			worker_context->unload();
+
+		gl_context.unload();
+		display.unload();
+
+		return shared == true ? 0 : 1;
+
+	} catch(const std::exception & error) {
+		std::cerr << error.what() << std::endl;
+		return 1;
+	}
+}
+
+#endif
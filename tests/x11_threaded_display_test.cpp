@@ -0,0 +1,117 @@
+// Only compile on Linux
+#if defined(__linux__) && !defined(NDM_HEADLESS)
+
+// NDM includes
+#include <ndm/display/threaded_display.hpp>
+#include <ndm/opengl/gl_context.hpp>
+
+// STD includes
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+// GL includes
+#include <GL/gl.h>
+
+// Main
+int main(int argc, char ** argv)
+{
+	// An optional frame count allows to run the test without user interaction (e.g. under Xvfb)
+	const long max_frames = argc > 1 ? std::atol(argv[1]) : -1;
+
+	try {
+		// The window and its events are handled by the event thread, this thread only renders
+		ndm::ThreadedDisplay display;
+		display.load("Threaded window", 900, 600, true);
+
+		// The window manager waits for the frames rendered by this thread when the window is resized
+		display.set_sync_resize(true);
+
+		// GL Context
+		ndm::GLContext gl_context(&display.get_display());
+		ndm::GLContextParams params = {};
+		params.debug_mode = false;
+		params.major_version = 3;
+		params.minor_version = 3;
+		params.double_buffer = true;
+		params.color_bits = 24;
+		params.alpha_bits = 0;
+		params.depth_bits = 24; 
+		params.stencil_bits = 8;
+		params.samples_buffers = false;
+		params.samples = 0;
+		gl_context.load(params);
+		if (gl_context.get_swap_control().swap_interval == true)
+			gl_context.set_vertical_sync(true);
+
+		std::cout << glGetString(GL_VERSION) << std::endl;
+		glClearColor(0, 0, 1.0f, 1);
+
+		// Run
+		bool running = true;
+		long frame = 0;
+		while (running == true)
+		{
+			// Get Events, the call never waits for the OS
+			for (const ndm::DisplayEvent & event : display.catch_events())
+			{
+				switch (event.type)
+				{
+					case ndm::DisplayEventType::RESIZED:
+						std::cout << "display : resized " << event.width << "x" << event.height << std::endl;
+						glViewport(0, 0, static_cast<GLsizei>(event.width), static_cast<GLsizei>(event.height));
+						break;
+					case ndm::DisplayEventType::MINIMIZED:
+						std::cout << "display : minimized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MAXIMIZED:
+						std::cout << "display : maximized" << std::endl;
+						break;
+					case ndm::DisplayEventType::MOVED:
+						std::cout << "display : moved " << event.x << ", " << event.y << std::endl;
+						break;
+					case ndm::DisplayEventType::MONITORS_CHANGED:
+						std::cout << "display : monitors changed" << std::endl;
+						break;
+					case ndm::DisplayEventType::CLOSED:
+						running = false;
+						std::cout << "display : closed" << std::endl;
+						break;
+					default:
+						break;
+				}
+			}
+
+			// The title is changed by the event thread
+			if (frame % 60 == 0)
+				display.set_title("Threaded window - frame " + std::to_string(frame));
+
+			// Test OpenGL
+			glClear(GL_COLOR_BUFFER_BIT);
+			gl_context.swap_front_and_back();
+
+			// Stop after the requested number of frames
+			frame++;
+			if (max_frames >= 0 && frame >= max_frames)
+				running = false;
+		}
+
+		// Frame statistics
+		const ndm::GLFrameStatistics & statistics = gl_context.get_frame_statistics();
+		std::cout << "frames: " << statistics.frame_count << std::endl;
+		std::cout << "frame time p50/p95/p99 (us): " << statistics.frame_time_p50.count() / 1000 << " / " 
+				  << statistics.frame_time_p95.count() / 1000 << " / " << statistics.frame_time_p99.count() / 1000 << std::endl;
+		std::cout << "failed commands: " << display.get_failed_command_count() << std::endl;
+
+		// Unload
+		gl_context.unload();
+		display.unload();
+	} catch(const std::exception & exception) {
+		std::cerr << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif